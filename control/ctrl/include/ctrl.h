@@ -79,6 +79,12 @@ extern "C" {
 // **************************************************************************
 // the defines
 
+//! \brief Defines the deadbeat disturbance observer gain, the fraction of the
+//!        current prediction error taken into the disturbance estimate per
+//!        current period. Higher values lose stability margin against an
+//!        inductance error
+#define CTRL_DEADBEAT_DIST_GAIN         ((float32_t)(0.25f))
+
 
 // **************************************************************************
 // the typedefs
@@ -1641,6 +1647,222 @@ static inline void CTRL_setGains(CTRL_Handle handle,const CTRL_Type_e ctrlType,
 } // end of CTRL_setGains() function
 
 
+//! \brief     Sets the current controller mode, changed while the current
+//!            controllers are disabled. The deadbeat mode is ignored until
+//!            CTRL_computeDeadbeatParams() has accepted the motor parameters
+//! \param[in] handle  The controller (CTRL) handle
+//! \param[in] mode    The current controller mode
+static inline void CTRL_setCurrentCtrlMode(CTRL_Handle handle,const CTRL_CurrentCtrlMode_e mode)
+{
+  CTRL_Obj *obj = (CTRL_Obj *)handle;
+
+  if((mode == CTRL_CURRENTCTRL_DEADBEAT) &&
+     ((obj->DB_gain_VpA.value[0] == (float32_t)0.0) ||
+      (obj->DB_gain_VpA.value[1] == (float32_t)0.0)))
+    {
+      return;
+    }
+
+  obj->currentCtrlMode = mode;
+
+  return;
+} // end of CTRL_setCurrentCtrlMode() function
+
+
+//! \brief     Computes the deadbeat current controller parameters from the
+//!            motor parameters and the current controller period
+//! \details   The parameters are rejected when an inductance is not positive,
+//!            the deadbeat gains are then zeroed and the PI current
+//!            controllers are selected
+//! \param[in] handle  The controller (CTRL) handle
+//! \return    true if the parameters are accepted, false otherwise
+extern bool CTRL_computeDeadbeatParams(CTRL_Handle handle);
+
+
+//! \brief     Runs the deadbeat current controller of one axis
+//! \details   The voltage computed now is applied over the next current
+//!            period, so the current at the start of that period is first
+//!            predicted from the voltage applied over the present one. The
+//!            output then brings the current to the reference at the end of
+//!            the next period. The feedforward is added on top, as with the
+//!            PI controllers
+//!
+//!            The dq cross coupling and back-EMF are taken out of the model
+//!            using the feedback speed (electrical), the other axis current
+//!            feedback and the rated flux:
+//!            d: e = w*Lq*iq, q: e = -w*(Ld*id + flux)
+//!
+//!            Whatever the model still misses, such as parameter errors,
+//!            inverter drops or a flux mismatch, is seen as the difference
+//!            between the predicted and the measured current. It is integrated
+//!            into a voltage disturbance estimate, which removes the
+//!            steady-state error
+//! \param[in] handle      The controller (CTRL) handle
+//! \param[in] axis        The axis, 0: d, 1: q
+//! \param[in] refValue    The current reference value, A
+//! \param[in] fbackValue  The current feedback value, A
+//! \param[in] ffwdValue   The voltage feedforward value, V
+//! \param[in] outMin      The minimum output value, V
+//! \param[in] outMax      The maximum output value, V
+//! \return    The voltage output value, V
+static inline float32_t CTRL_runDeadbeat(CTRL_Handle handle,const uint16_t axis,
+                                         const float32_t refValue,
+                                         const float32_t fbackValue,
+                                         const float32_t ffwdValue,
+                                         const float32_t outMin,
+                                         const float32_t outMax)
+{
+  CTRL_Obj *obj = (CTRL_Obj *)handle;
+  float32_t a = obj->DB_a.value[axis];
+  float32_t gain_VpA = obj->DB_gain_VpA.value[axis];
+  float32_t speed_rps = MATH_TWO_PI * obj->speed_fb_Hz;
+  float32_t dist_V;
+  float32_t emf_V;
+  float32_t Ipred_A;
+  float32_t out_V;
+
+  // update the disturbance estimate from the last prediction error
+  dist_V = obj->DB_Vdq_dist_V.value[axis] +
+           (CTRL_DEADBEAT_DIST_GAIN * gain_VpA *
+            (fbackValue - obj->DB_Idq_pred_A.value[axis]));
+  obj->DB_Vdq_dist_V.value[axis] = dist_V;
+
+  // the cross coupling and back-EMF voltages
+  if(axis == 0)
+    {
+      emf_V = speed_rps * obj->motorParams.Ls_q_H * obj->Idq_A.value[1];
+    }
+  else
+    {
+      emf_V = -speed_rps * ((obj->motorParams.Ls_d_H * obj->Idq_A.value[0]) +
+                            obj->motorParams.ratedFlux_Wb);
+    }
+
+  dist_V += emf_V;
+
+  // predict the current at the start of the next period
+  Ipred_A = (a * fbackValue) +
+            (obj->DB_b_ApV.value[axis] * (obj->DB_Vdq_prev_V.value[axis] + dist_V));
+
+  // reach the reference at the end of the next period
+  out_V = (gain_VpA * (refValue - (a * Ipred_A))) - dist_V + ffwdValue;
+
+#ifdef __TMS320C28XX_CLA__
+  out_V = MATH_sat(out_V,outMax,outMin);
+#else
+  out_V = __fsat(out_V,outMax,outMin);
+#endif  // __TMS320C28XX_CLA__
+
+  // the prediction uses the voltage that is actually applied
+  obj->DB_Vdq_prev_V.value[axis] = out_V - ffwdValue;
+  obj->DB_Idq_pred_A.value[axis] = Ipred_A;
+
+  return(out_V);
+} // end of CTRL_runDeadbeat() function
+
+
+//! \brief     Sets the gain schedule
+//! \param[in] handle      The controller (CTRL) handle
+//! \param[in] pGainSched  The pointer to the gain schedule, NULL for the fixed gains
+static inline void CTRL_setGainSched(CTRL_Handle handle,const CTRL_GainSched *pGainSched)
+{
+  CTRL_Obj *obj = (CTRL_Obj *)handle;
+
+  obj->pGainSched = pGainSched;
+
+  return;
+} // end of CTRL_setGainSched() function
+
+
+//! \brief     Initializes the grid of a gain schedule
+//! \param[in] pSched       The pointer to the gain schedule
+//! \param[in] speedMax_Hz  The speed of the last speed point, Hz
+//! \param[in] IqMax_A      The Iq of the last Iq point, A
+//! \param[in] numIq        The number of Iq points, 1 to CTRL_GAINSCHED_IQ_NUM
+extern void CTRL_initGainSched(CTRL_GainSched *pSched,const float32_t speedMax_Hz,
+                               const float32_t IqMax_A,const uint16_t numIq);
+
+
+//! \brief     Builds one Iq row of a gain schedule from speed design points
+//! \param[in] pSched     The pointer to the gain schedule
+//! \param[in] IqIndex    The Iq row, 0 to numIq - 1
+//! \param[in] pPoints    The pointer to the design points, ascending speed
+//! \param[in] numPoints  The number of design points
+extern void CTRL_buildGainSchedRow(CTRL_GainSched *pSched,const uint16_t IqIndex,
+                                   const CTRL_GainPoint *pPoints,const uint16_t numPoints);
+
+
+//! \brief     Updates the controller gains from the gain schedule at the
+//!            feedback speed and the Iq reference, called in the speed tick
+//! \param[in] handle  The controller (CTRL) handle
+static inline void CTRL_runGainSched(CTRL_Handle handle)
+{
+  CTRL_Obj *obj = (CTRL_Obj *)handle;
+  const CTRL_GainSched *pSched = obj->pGainSched;
+  const float32_t *pKp, *pKi;
+  float32_t speedPos = MATH_abs(obj->speed_fb_Hz) * pSched->speedStepInv_1oHz;
+  float32_t IqPos = MATH_abs(obj->Idq_ref_A.value[1]) * pSched->IqStepInv_1oA;
+  float32_t speedFrac, IqFrac;
+  float32_t Kp[CTRL_GAINSCHED_NUM_TYPES];
+  float32_t Ki[CTRL_GAINSCHED_NUM_TYPES];
+  int16_t speedIndex, IqIndex;
+  uint16_t rowOffset, type;
+
+  // hold the end gains outside of the grid
+  speedPos = MATH_min(speedPos, (float32_t)(CTRL_GAINSCHED_SPEED_NUM - 1));
+  speedIndex = (int16_t)speedPos;
+  speedIndex = (speedIndex > (CTRL_GAINSCHED_SPEED_NUM - 2)) ?
+               (CTRL_GAINSCHED_SPEED_NUM - 2) : speedIndex;
+  speedFrac = speedPos - (float32_t)speedIndex;
+
+  if(pSched->numIq > 1)
+    {
+      IqPos = MATH_min(IqPos, (float32_t)(pSched->numIq - 1));
+      IqIndex = (int16_t)IqPos;
+      IqIndex = (IqIndex > ((int16_t)pSched->numIq - 2)) ?
+                ((int16_t)pSched->numIq - 2) : IqIndex;
+      IqFrac = IqPos - (float32_t)IqIndex;
+      rowOffset = CTRL_GAINSCHED_SPEED_NUM;
+    }
+  else
+    {
+      IqIndex = 0;
+      IqFrac = 0.0f;
+      rowOffset = 0;
+    }
+
+  for(type = 0; type < CTRL_GAINSCHED_NUM_TYPES; type++)
+    {
+      float32_t Kp0, Kp1, Ki0, Ki1;
+
+      pKp = &pSched->Kp[type][IqIndex][speedIndex];
+      pKi = &pSched->Ki[type][IqIndex][speedIndex];
+
+      Kp0 = pKp[0] + (pKp[1] - pKp[0]) * speedFrac;
+      Ki0 = pKi[0] + (pKi[1] - pKi[0]) * speedFrac;
+
+      Kp1 = pKp[rowOffset] + (pKp[rowOffset + 1] - pKp[rowOffset]) * speedFrac;
+      Ki1 = pKi[rowOffset] + (pKi[rowOffset + 1] - pKi[rowOffset]) * speedFrac;
+
+      Kp[type] = Kp0 + (Kp1 - Kp0) * IqFrac;
+      Ki[type] = Ki0 + (Ki1 - Ki0) * IqFrac;
+    }
+
+  obj->Kp_spd_ApHz = Kp[CTRL_TYPE_PI_SPD];
+  obj->Ki_spd_ApHz = Ki[CTRL_TYPE_PI_SPD];
+  obj->Kp_Id_VpA = Kp[CTRL_TYPE_PI_ID];
+  obj->Ki_Id = Ki[CTRL_TYPE_PI_ID];
+  obj->Kp_Iq_VpA = Kp[CTRL_TYPE_PI_IQ];
+  obj->Ki_Iq = Ki[CTRL_TYPE_PI_IQ];
+
+  PI_setGains(obj->piHandle_spd,obj->Kp_spd_ApHz,obj->Ki_spd_ApHz);
+  PI_setGains(obj->piHandle_Id,obj->Kp_Id_VpA,obj->Ki_Id);
+  PI_setGains(obj->piHandle_Iq,obj->Kp_Iq_VpA,obj->Ki_Iq);
+
+  return;
+} // end of CTRL_runGainSched() function
+
+
 //! \brief     Sets the maximum stator voltage magnitude value
 //! \param[in] handle      The controller (CTRL) handle
 //! \param[in] maxVsMax_V  The maximum stator voltage magnitude value, V
@@ -2055,6 +2277,12 @@ static inline void CTRL_run(CTRL_Handle handle,MATH_Vec2 *pVdq_V)
          // reset the speed count
          CTRL_resetCounter_speed(handle);
 
+         // update the gains from the gain schedule
+         if(obj->pGainSched != NULL)
+           {
+             CTRL_runGainSched(handle);
+           }
+
          // set the minimum and maximum values
          PI_setMinMax(obj->piHandle_spd, outMin_A, outMax_A);
 
@@ -2105,8 +2333,16 @@ static inline void CTRL_run(CTRL_Handle handle,MATH_Vec2 *pVdq_V)
          // set the minimum and maximum values
          PI_setMinMax(obj->piHandle_Id,outMin_V,outMax_V);
 
-         // run the Id PI controller
-         PI_run_series(obj->piHandle_Id,refValue_A,fbackValue_A,ffwdValue_V,&(pVdq_V->value[0]));
+         // run the Id controller
+         if(obj->currentCtrlMode == CTRL_CURRENTCTRL_DEADBEAT)
+           {
+             pVdq_V->value[0] = CTRL_runDeadbeat(handle,0,refValue_A,fbackValue_A,
+                                                 ffwdValue_V,outMin_V,outMax_V);
+           }
+         else
+           {
+             PI_run_series(obj->piHandle_Id,refValue_A,fbackValue_A,ffwdValue_V,&(pVdq_V->value[0]));
+           }
 
          // store the Id reference value
          CTRL_setId_ref_A(handle,refValue_A);
@@ -2145,8 +2381,16 @@ static inline void CTRL_run(CTRL_Handle handle,MATH_Vec2 *pVdq_V)
          // set the minimum and maximum values
          PI_setMinMax(obj->piHandle_Iq,outMin_V,outMax_V);
 
-         // run the Iq PI controller
-         PI_run_series(obj->piHandle_Iq,refValue_A,fbackValue_A,ffwdValue_V,&(pVdq_V->value[1]));
+         // run the Iq controller
+         if(obj->currentCtrlMode == CTRL_CURRENTCTRL_DEADBEAT)
+           {
+             pVdq_V->value[1] = CTRL_runDeadbeat(handle,1,refValue_A,fbackValue_A,
+                                                 ffwdValue_V,outMin_V,outMax_V);
+           }
+         else
+           {
+             PI_run_series(obj->piHandle_Iq,refValue_A,fbackValue_A,ffwdValue_V,&(pVdq_V->value[1]));
+           }
 
          // store the Iq reference value
          CTRL_setIq_ref_A(handle,refValue_A);
@@ -85,6 +85,22 @@ extern "C" {
 #define CTRL_NUM_CONTROLLERS            (2)
 
 
+//! \brief Defines the number of controller types in the gain schedule,
+//!        indexed by CTRL_Type_e
+//!
+#define CTRL_GAINSCHED_NUM_TYPES        (3)
+
+
+//! \brief Defines the number of speed points in the gain schedule
+//!
+#define CTRL_GAINSCHED_SPEED_NUM        (17)
+
+
+//! \brief Defines the maximum number of Iq points in the gain schedule
+//!
+#define CTRL_GAINSCHED_IQ_NUM           (3)
+
+
 // **************************************************************************
 // the typedefs
 
@@ -120,6 +136,15 @@ typedef enum
 } CTRL_Type_e;
 
 
+//! \brief Enumeration for the current controller modes
+//!
+typedef enum
+{
+  CTRL_CURRENTCTRL_PI = 0,          //!< series PI current controllers
+  CTRL_CURRENTCTRL_DEADBEAT = 1     //!< deadbeat current controllers with delay compensation
+} CTRL_CurrentCtrlMode_e;
+
+
 //! \brief Defines the controller (CTRL) version number
 //!
 typedef struct _CTRL_Version_
@@ -131,6 +156,37 @@ typedef struct _CTRL_Version_
 } CTRL_Version;
 
 
+//! \brief Defines a design point of the gain schedule
+//!
+typedef struct _CTRL_GainPoint_
+{
+  float32_t speed_Hz;                          //!< the speed of the design point, Hz
+  float32_t Kp[CTRL_GAINSCHED_NUM_TYPES];      //!< the Kp values, indexed by CTRL_Type_e
+  float32_t Ki[CTRL_GAINSCHED_NUM_TYPES];      //!< the Ki values, indexed by CTRL_Type_e
+} CTRL_GainPoint;
+
+
+//! \brief Defines the speed (and Iq) scheduled gain table
+//!
+//! The gains are stored on a uniform grid from zero to the maximum speed and
+//! the maximum Iq, so the lookup is an index computation and a bilinear
+//! interpolation. The table is built once from a few design points by
+//! CTRL_initGainSched() and CTRL_buildGainSchedRow(), or is a const table
+//! generated offline.
+//!
+typedef struct _CTRL_GainSched_
+{
+  float32_t speedStepInv_1oHz;                 //!< the inverse of the speed step, 1/Hz
+  float32_t IqStepInv_1oA;                     //!< the inverse of the Iq step, 1/A
+  uint16_t  numIq;                             //!< the number of Iq points, 1 is speed only
+
+  float32_t Kp[CTRL_GAINSCHED_NUM_TYPES][CTRL_GAINSCHED_IQ_NUM][CTRL_GAINSCHED_SPEED_NUM];
+                                               //!< the Kp values
+  float32_t Ki[CTRL_GAINSCHED_NUM_TYPES][CTRL_GAINSCHED_IQ_NUM][CTRL_GAINSCHED_SPEED_NUM];
+                                               //!< the Ki values
+} CTRL_GainSched;
+
+
 //! \brief Defines the controller (CTRL) object
 //!
 typedef struct _CTRL_Obj_
@@ -221,6 +277,17 @@ typedef struct _CTRL_Obj_
   bool               flag_resetInt_Iq;             //!< a flag to reset the Iq integrator
 
   bool               flag_useZeroIq_ref;           //!< a flag to force a Iq = 0 reference value
+
+  const CTRL_GainSched *pGainSched;                //!< the gain schedule, NULL for fixed gains
+
+  CTRL_CurrentCtrlMode_e currentCtrlMode;          //!< the current controller mode
+
+  MATH_Vec2          DB_a;                         //!< the deadbeat current decay per current period, d/q
+  MATH_Vec2          DB_b_ApV;                     //!< the deadbeat current change per volt over a current period, d/q, A/V
+  MATH_Vec2          DB_gain_VpA;                  //!< the deadbeat gain, 1/DB_b_ApV, d/q, V/A
+  MATH_Vec2          DB_Vdq_prev_V;                //!< the last applied Vdq less the feedforward, V
+  MATH_Vec2          DB_Idq_pred_A;                //!< the Idq predicted for the next current sample, A
+  MATH_Vec2          DB_Vdq_dist_V;                //!< the estimated Vdq disturbance left after the decoupling, V
 } CTRL_Obj;
 
 
@@ -152,9 +152,133 @@ CTRL_init(void *pMemory, const size_t numBytes)
     //
     obj->piHandle_spd = PI_init(&obj->pi_spd,sizeof(obj->pi_spd));
 
+    //
+    // Use the fixed gains
+    //
+    obj->pGainSched = (const CTRL_GainSched *)NULL;
+
+    //
+    // Use the PI current controllers
+    //
+    obj->currentCtrlMode = CTRL_CURRENTCTRL_PI;
+    obj->DB_gain_VpA.value[0] = (float32_t)0.0;
+    obj->DB_gain_VpA.value[1] = (float32_t)0.0;
+
     return(handle);
 } // end of CTRL_init() function
 
+//*****************************************************************************
+//
+// CTRL_initGainSched
+//
+//*****************************************************************************
+void
+CTRL_initGainSched(CTRL_GainSched *pSched, const float32_t speedMax_Hz,
+                   const float32_t IqMax_A, const uint16_t numIq)
+{
+    pSched->speedStepInv_1oHz = (float32_t)(CTRL_GAINSCHED_SPEED_NUM - 1) /
+                                speedMax_Hz;
+
+    pSched->numIq = (numIq > CTRL_GAINSCHED_IQ_NUM) ? CTRL_GAINSCHED_IQ_NUM :
+                    ((numIq < 1) ? 1 : numIq);
+
+    if(pSched->numIq > 1)
+    {
+        pSched->IqStepInv_1oA = (float32_t)(pSched->numIq - 1) / IqMax_A;
+    }
+    else
+    {
+        pSched->IqStepInv_1oA = 0.0f;
+    }
+
+    return;
+} // end of CTRL_initGainSched() function
+
+//*****************************************************************************
+//
+// CTRL_buildGainSchedRow
+//
+//*****************************************************************************
+void
+CTRL_buildGainSchedRow(CTRL_GainSched *pSched, const uint16_t IqIndex,
+                       const CTRL_GainPoint *pPoints, const uint16_t numPoints)
+{
+    float32_t speed_Hz, frac;
+    uint16_t cnt, type;
+    uint16_t point = 0;
+
+    if((IqIndex >= pSched->numIq) || (numPoints < 1))
+    {
+        return;
+    }
+
+    //
+    // Resample the piecewise linear design curve on the uniform speed grid,
+    // the gains are held below the first and above the last design point
+    //
+    for(cnt = 0; cnt < CTRL_GAINSCHED_SPEED_NUM; cnt++)
+    {
+        speed_Hz = (float32_t)cnt / pSched->speedStepInv_1oHz;
+
+        while(((point + 1) < (numPoints - 1)) &&
+              (speed_Hz > pPoints[point + 1].speed_Hz))
+        {
+            point++;
+        }
+
+        if((numPoints == 1) || (speed_Hz <= pPoints[0].speed_Hz))
+        {
+            frac = 0.0f;
+        }
+        else if(speed_Hz >= pPoints[numPoints - 1].speed_Hz)
+        {
+            point = numPoints - 2;
+            frac = 1.0f;
+        }
+        else
+        {
+            frac = (speed_Hz - pPoints[point].speed_Hz) /
+                   (pPoints[point + 1].speed_Hz - pPoints[point].speed_Hz);
+        }
+
+        for(type = 0; type < CTRL_GAINSCHED_NUM_TYPES; type++)
+        {
+            if(numPoints == 1)
+            {
+                pSched->Kp[type][IqIndex][cnt] = pPoints[0].Kp[type];
+                pSched->Ki[type][IqIndex][cnt] = pPoints[0].Ki[type];
+            }
+            else
+            {
+                pSched->Kp[type][IqIndex][cnt] = pPoints[point].Kp[type] +
+                        (pPoints[point + 1].Kp[type] - pPoints[point].Kp[type]) * frac;
+                pSched->Ki[type][IqIndex][cnt] = pPoints[point].Ki[type] +
+                        (pPoints[point + 1].Ki[type] - pPoints[point].Ki[type]) * frac;
+            }
+        }
+    }
+
+    return;
+} // end of CTRL_buildGainSchedRow() function
+
+//*****************************************************************************
+//
+// CTRL_resetDeadbeat
+//
+//*****************************************************************************
+static void
+CTRL_resetDeadbeat(CTRL_Obj *obj)
+{
+    obj->DB_Vdq_prev_V.value[0] = (float32_t)0.0;
+    obj->DB_Vdq_prev_V.value[1] = (float32_t)0.0;
+    obj->DB_Idq_pred_A.value[0] = (float32_t)0.0;
+    obj->DB_Idq_pred_A.value[1] = (float32_t)0.0;
+    obj->DB_Vdq_dist_V.value[0] = (float32_t)0.0;
+    obj->DB_Vdq_dist_V.value[1] = (float32_t)0.0;
+
+    return;
+} // end of CTRL_resetDeadbeat() function
+
 //*****************************************************************************
 //
 // CTRL_reset
@@ -173,6 +297,9 @@ CTRL_reset(CTRL_Handle handle)
     PI_setUi(obj->piHandle_Id,(float32_t)0.0);
     PI_setUi(obj->piHandle_Iq,(float32_t)0.0);
 
+    // Reset the deadbeat voltage history and disturbance estimate
+    CTRL_resetDeadbeat(obj);
+
     //
     // Zero internal values
     //
@@ -359,9 +486,78 @@ CTRL_setParams(CTRL_Handle handle, USER_Params *pUserParams)
     CTRL_setUi(handle,CTRL_TYPE_PI_ID,(float32_t)0.0);
     CTRL_setUi(handle,CTRL_TYPE_PI_IQ,(float32_t)0.0);
 
+    //
+    // Configure the deadbeat current controllers, PI by default
+    //
+    CTRL_setCurrentCtrlMode(handle,CTRL_CURRENTCTRL_PI);
+    (void)CTRL_computeDeadbeatParams(handle);
+    CTRL_resetDeadbeat(obj);
+
     return;
 } // end of CTRL_setParams() function
 
+//*****************************************************************************
+//
+// CTRL_computeDeadbeatParams
+//
+//*****************************************************************************
+bool
+CTRL_computeDeadbeatParams(CTRL_Handle handle)
+{
+    CTRL_Obj *obj = (CTRL_Obj *)handle;
+    float32_t Rs_Ohm[2];
+    float32_t Ls_H[2];
+    float32_t a, b_ApV;
+    uint16_t axis;
+
+    Rs_Ohm[0] = obj->motorParams.Rs_d_Ohm;
+    Rs_Ohm[1] = obj->motorParams.Rs_q_Ohm;
+    Ls_H[0] = obj->motorParams.Ls_d_H;
+    Ls_H[1] = obj->motorParams.Ls_q_H;
+
+    //
+    // The model divides by the inductances, without them the deadbeat
+    // controllers have no gains and only the PI controllers are left
+    //
+    if((Ls_H[0] <= (float32_t)0.0) || (Ls_H[1] <= (float32_t)0.0))
+    {
+        for(axis = 0; axis < 2; axis++)
+        {
+            obj->DB_a.value[axis] = (float32_t)0.0;
+            obj->DB_b_ApV.value[axis] = (float32_t)0.0;
+            obj->DB_gain_VpA.value[axis] = (float32_t)0.0;
+        }
+
+        obj->currentCtrlMode = CTRL_CURRENTCTRL_PI;
+
+        return(false);
+    }
+
+    //
+    // Zero order hold model of the R-L circuit over a current period,
+    // i[k+1] = a * i[k] + b * v[k], a = exp(-R*T/L), b = (1 - a) / R
+    //
+    for(axis = 0; axis < 2; axis++)
+    {
+        a = expf(-Rs_Ohm[axis] * obj->currentCtrlPeriod_sec / Ls_H[axis]);
+
+        if(Rs_Ohm[axis] > (float32_t)0.0)
+        {
+            b_ApV = ((float32_t)1.0 - a) / Rs_Ohm[axis];
+        }
+        else
+        {
+            b_ApV = obj->currentCtrlPeriod_sec / Ls_H[axis];
+        }
+
+        obj->DB_a.value[axis] = a;
+        obj->DB_b_ApV.value[axis] = b_ApV;
+        obj->DB_gain_VpA.value[axis] = (float32_t)1.0 / b_ApV;
+    }
+
+    return(true);
+} // end of CTRL_computeDeadbeatParams() function
+
 //*****************************************************************************
 //
 // CTRL_setVersion
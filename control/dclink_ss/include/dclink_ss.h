@@ -67,6 +67,20 @@ extern "C"
 #include "types.h"
 #include "libraries/math/include/math.h"
 
+//! \brief Enables the sampling sweep of a host build, the sweep and its shunt
+//!        model are not built into the target library when not defined
+//!
+//#define DCLINK_SS_SWEEP     1
+
+#ifdef DCLINK_SS_SWEEP
+//! \brief Reads a free running 32-bit up counter to measure the cost of the
+//!        compensation and reconstruction in DCLINK_SS_runSamplingSweep(),
+//!        the mean count is zero when not defined
+#ifndef DCLINK_SS_SWEEP_GET_COUNT
+#define DCLINK_SS_SWEEP_GET_COUNT()     (0U)
+#endif  //DCLINK_SS_SWEEP_GET_COUNT
+#endif  //DCLINK_SS_SWEEP
+
 //*****************************************************************************
 //
 //! \brief Defines unsigned integer three element vector
@@ -134,6 +148,87 @@ typedef struct _DCLINK_SS_Obj_
 
 typedef struct _DCLINK_SS_Obj_ *DCLINK_SS_Handle;
 
+//*****************************************************************************
+//
+//! \brief Defines the phase order of the compare values
+//!
+//! The table is indexed by the comparison code of the three compare values,
+//! (cmp[0] > cmp[1]) * 4 + (cmp[1] > cmp[2]) * 2 + (cmp[0] > cmp[2]), and
+//! gives the same stable min/mid/max order as the comparisons it replaces
+//
+//*****************************************************************************
+typedef struct _DCLINK_SS_SortEntry_
+{
+    uint16_t sector;        //!< the sector of the compare values
+    uint16_t index[3];      //!< the phase of min cmp, mid cmp and max cmp
+} DCLINK_SS_SortEntry;
+
+//*****************************************************************************
+//
+//! \brief Defines the phase permutation of the current reconstruction
+//!
+//! The first sample gives the negative current of phase index[0], the second
+//! sample gives the current of phase index[1] and the current of phase
+//! index[2] is the negative sum of both
+//
+//*****************************************************************************
+typedef struct _DCLINK_SS_ReconEntry_
+{
+    uint16_t index[3];      //!< the phase of the 1st, 2nd sample and the rest
+} DCLINK_SS_ReconEntry;
+
+#ifdef DCLINK_SS_SWEEP
+//*****************************************************************************
+//
+//! \brief Defines the sampling path of DCLINK_SS_runSamplingSweep()
+//
+//*****************************************************************************
+typedef enum
+{
+    DCLINK_SS_SWEEP_FAST     = 0,   //!< DCLINK_SS_runFastPWMCompensation() and
+                                    //!< DCLINK_SS_runFastCurrentReconstruction()
+    DCLINK_SS_SWEEP_STANDARD = 1    //!< DCLINK_SS_runPWMCompensation() and
+                                    //!< DCLINK_SS_runCurrentReconstruction(),
+                                    //!< with the full sampling and sequence
+                                    //!< control flags set in the object
+} DCLINK_SS_SweepPath_e;
+
+//*****************************************************************************
+//
+//! \brief Defines the result of DCLINK_SS_runSamplingSweep()
+//
+//*****************************************************************************
+typedef struct _DCLINK_SS_SweepResult_
+{
+    float32_t errorMax_A;       //!< the maximum phase current error
+    float32_t errorRms_A;       //!< the rms phase current error
+    float32_t errorMaxMod;      //!< the modulation index of the maximum error
+    float32_t countMean;        //!< the mean counts of the compensation and
+                                //!< reconstruction of one PWM cycle
+    uint32_t numPoints;         //!< the number of operating points
+    uint32_t numWindowFail;     //!< the number of used samples with a
+                                //!< switching edge in the sampling window
+} DCLINK_SS_SweepResult;
+#endif  //DCLINK_SS_SWEEP
+
+//! \brief Defines the compare value order table
+extern const DCLINK_SS_SortEntry DCLINK_SS_sortTable[8];
+
+//! \brief Defines the sector of DCLINK_SS_runPWMCompensation(), indexed by
+//!        the sector of DCLINK_SS_sortTable[]
+extern const uint16_t DCLINK_SS_sectorTable[8];
+
+//! \brief Defines the permutation table of DCLINK_SS_runCurrentReconstruction()
+extern const DCLINK_SS_ReconEntry DCLINK_SS_reconTable[8];
+
+//! \brief Defines the permutation table of
+//!        DCLINK_SS_runFastCurrentReconstruction()
+extern const DCLINK_SS_ReconEntry DCLINK_SS_fastReconTable[8];
+
+//! \brief Defines the Idc sample weights of the current reconstruction,
+//!        indexed by 0: down count, 1: up count, 2: up and down count
+extern const float32_t DCLINK_SS_sampleWeight[3][2];
+
 // **************************************************************************
 // the function prototypes
 
@@ -171,6 +266,114 @@ DCLINK_SS_setInitialConditions(DCLINK_SS_Handle handle,
                                const uint16_t pwmPeriod,
                                const float32_t SSTOffThrVs_pu);
 
+#ifdef DCLINK_SS_SWEEP
+//*****************************************************************************
+//
+//! \brief     Models the dc-link shunt current seen by an ADC sample
+//!
+//! The phase leg x is on when the up-down counter is at or above
+//! pPwmCMPA->value[x] on up count and pPwmCMPB->value[x] on down count, and
+//! the shunt carries the sum of the currents of the phases that are on. Used
+//! to drive the compensation and reconstruction functions with known phase
+//! currents when tuning the sampling windows off the bench
+//
+//! \param[in] pPwmCMPA   The pointer to the PWM compare-A values
+//
+//! \param[in] pPwmCMPB   The pointer to the PWM compare-B values
+//
+//! \param[in] pI_A       The pointer to the three-phase currents
+//
+//! \param[in] socCount   The counter value of the SOC trigger
+//
+//! \param[in] flagUpCount  The SOC trigger is on up count (true) or down
+//!                         count (false)
+//
+//! \return    The modeled dc-link current
+//
+//*****************************************************************************
+extern float32_t
+DCLINK_SS_computeShuntCurrent(const MATH_ui_vec3 *pPwmCMPA,
+                              const MATH_ui_vec3 *pPwmCMPB,
+                              const MATH_vec3 *pI_A,
+                              const uint16_t socCount, const bool flagUpCount);
+
+//*****************************************************************************
+//
+//! \brief     Checks that no phase switches inside the ADC sampling window
+//!
+//! The sampling window starts sampleDelay ticks before the SOC trigger, so
+//! the shunt signal is settled, and ends sampleHoldTime ticks after it
+//
+//! \param[in] handle     The DC-Link Single-Shunt(DCLINK_SS) handle
+//
+//! \param[in] pPwmCMPA   The pointer to the PWM compare-A values
+//
+//! \param[in] pPwmCMPB   The pointer to the PWM compare-B values
+//
+//! \param[in] socCount   The counter value of the SOC trigger
+//
+//! \param[in] flagUpCount  The SOC trigger is on up count (true) or down
+//!                         count (false)
+//
+//! \return    true if the switching state is constant over the window
+//
+//*****************************************************************************
+extern bool
+DCLINK_SS_checkSampleWindow(DCLINK_SS_Handle handle,
+                            const MATH_ui_vec3 *pPwmCMPA,
+                            const MATH_ui_vec3 *pPwmCMPB,
+                            const uint16_t socCount, const bool flagUpCount);
+
+//*****************************************************************************
+//
+//! \brief     Sweeps the sampling over modulation index and angle
+//!
+//! At each operating point the space vector compare values and a current
+//! phasor of amplitude Is_A are built, the compensation of the selected path
+//! runs until its one cycle delayed states are settled, the shunt samples
+//! are taken from DCLINK_SS_computeShuntCurrent() at the SOC triggers and
+//! the reconstructed currents are compared with the phasor. A sample with a
+//! nonzero reconstruction weight and a switching edge inside its window is
+//! counted in numWindowFail. The modulation index is 1.0 at a phase voltage
+//! amplitude of Vdc/2. The sweep runs on a copy of the object, so it takes
+//! the settings of handle and leaves its state unchanged.
+//!
+//! The sweep is meant for a host build to choose the sampling settings.
+//! With pwmPeriod 2000, sampleDelay 50, sampleHoldTime 20 and minAvDuration
+//! 90 no sample window fails and the currents are reconstructed without
+//! error on either path. Full sampling adds up count samples that are the
+//! first to fail when the window is widened, and sequence control does not
+//! change the sampled currents, so full sampling is left off and sequence
+//! control is kept on for its smoother injection at the sector change
+//
+//! \param[in] handle    The DC-Link Single-Shunt(DCLINK_SS) handle
+//
+//! \param[in] path      The sampling path to evaluate
+//
+//! \param[in] modMax    The highest modulation index of the sweep
+//
+//! \param[in] numMod    The number of modulation index points up to modMax
+//
+//! \param[in] numAngle  The number of angle points over one electrical turn
+//
+//! \param[in] Is_A      The phase current amplitude
+//
+//! \param[in] phi_rad   The angle of the current phasor to the voltage phasor
+//
+//! \param[out] pResult  The pointer to the sweep result
+//
+//! \return    None
+//
+//*****************************************************************************
+extern void
+DCLINK_SS_runSamplingSweep(DCLINK_SS_Handle handle,
+                           const DCLINK_SS_SweepPath_e path,
+                           const float32_t modMax, const uint16_t numMod,
+                           const uint16_t numAngle, const float32_t Is_A,
+                           const float32_t phi_rad,
+                           DCLINK_SS_SweepResult *pResult);
+#endif  //DCLINK_SS_SWEEP
+
 //*****************************************************************************
 //
 //! \brief     Run the three-phase current reconstruction
@@ -190,42 +393,23 @@ DCLINK_SS_runCurrentReconstruction(DCLINK_SS_Handle handle,
                                 const MATH_vec2 *pIdc1, const MATH_vec2 *pIdc2)
 {
     DCLINK_SS_Obj *obj = (DCLINK_SS_Obj *)handle;
+    const DCLINK_SS_ReconEntry *pRecon;
+    const float32_t *pWeight;
     MATH_vec2 Idc;
+    uint16_t mode;
 
-    if(obj->flagEnableFullSample == true)
-    {
-        if(obj->vecArea_1 == 0)         // measurement vector is on up and down count
-        {
-            Idc.value[0] = (pIdc1->value[1] + pIdc2->value[0]) * 0.5f;
-            Idc.value[1] = (pIdc1->value[0] + pIdc2->value[1]) * 0.5f;
-        }
-        else // star/bar area
-        {
-            if(obj->flag_SST_1 == 0)    // measurement vector is on down count
-            {
-                Idc.value[0] = pIdc2->value[0];
-                Idc.value[1] = pIdc2->value[1];
-            }
-            else                        // measurement vector is on up count
-            {
-                Idc.value[0] = pIdc1->value[1];
-                Idc.value[1] = pIdc1->value[0];
-            }
-        }
-    }
-    else    // false
-    {
-        if(obj->flag_SST_1 == 0)        // measurement vector is on down count
-        {
-            Idc.value[0] = pIdc2->value[0];
-            Idc.value[1] = pIdc2->value[1];
-        }
-        else                            // measurement vector is on up count
-        {
-            Idc.value[0] = pIdc1->value[1];
-            Idc.value[1] = pIdc1->value[0];
-        }
-    }
+    //
+    // mode 2: measurement vector is on up and down count (full sampling)
+    // mode 1: measurement vector is on up count
+    // mode 0: measurement vector is on down count
+    //
+    mode = ((obj->flagEnableFullSample == true) && (obj->vecArea_1 == 0)) ?
+           2 : (obj->flag_SST_1 != 0);
+
+    pWeight = &DCLINK_SS_sampleWeight[mode][0];
+
+    Idc.value[0] = pWeight[0] * pIdc1->value[1] + pWeight[1] * pIdc2->value[0];
+    Idc.value[1] = pWeight[0] * pIdc1->value[0] + pWeight[1] * pIdc2->value[1];
 
     //
     //Sector    1st_Sample       2nd_Sample   Actual_Sector
@@ -236,40 +420,15 @@ DCLINK_SS_runCurrentReconstruction(DCLINK_SS_Handle handle,
     //  5       0,1,1 (-Ia)      0,1,0 (+Ib)      3
     //  6       1,0,1 (-Ib)      0,0,1 (+Ic)      5
     //
-    switch(obj->sector_1)
+    if((obj->sector_1 >= 1) && (obj->sector_1 <= 6))
     {
-        case 1:     // 1,1,0 (-Ic)      0,1,0 (+Ib)
-            obj->I_A.value[2] = -Idc.value[0];
-            obj->I_A.value[1] = Idc.value[1];
-            obj->I_A.value[0] = -obj->I_A.value[1] - obj->I_A.value[2];
-            break;
-        case 2:     //  1,0,1 (-Ib)      1,0,0 (+Ia)
-            obj->I_A.value[1] = -Idc.value[0];
-            obj->I_A.value[0] = Idc.value[1];
-            obj->I_A.value[2] = -obj->I_A.value[0] - obj->I_A.value[1];
-            break;
-        case 3:     //  1,1,0 (-Ic)      1,0,0 (+Ia)
-            obj->I_A.value[2] = -Idc.value[0];
-            obj->I_A.value[0] = Idc.value[1];
-            obj->I_A.value[1] = -obj->I_A.value[0] - obj->I_A.value[2];
-            break;
-        case 4:     //  0,1,1 (-Ia)      0,0,1 (+Ic)
-            obj->I_A.value[0] = -Idc.value[0];
-            obj->I_A.value[2] = Idc.value[1];
-            obj->I_A.value[1] = -obj->I_A.value[0] - obj->I_A.value[2];
-            break;
-        case 5:     //  0,1,1 (-Ia)      0,1,0 (+Ib)
-            obj->I_A.value[0] = -Idc.value[0];
-            obj->I_A.value[1] = Idc.value[1];
-            obj->I_A.value[2] = -obj->I_A.value[0] - obj->I_A.value[1];
-            break;
-        case 6:     //  1,0,1 (-Ib)      0,0,1 (+Ic)
-            obj->I_A.value[1] = -Idc.value[0];
-            obj->I_A.value[2] = Idc.value[1];
-            obj->I_A.value[0] = -obj->I_A.value[1] - obj->I_A.value[2];
-            break;
-        default:
-            break;
+        pRecon = &DCLINK_SS_reconTable[obj->sector_1];
+
+        obj->I_A.value[pRecon->index[0]] = -Idc.value[0];
+        obj->I_A.value[pRecon->index[1]] = Idc.value[1];
+        obj->I_A.value[pRecon->index[2]] =
+                -obj->I_A.value[pRecon->index[1]] -
+                 obj->I_A.value[pRecon->index[0]];
     }
 
     return;
@@ -298,77 +457,42 @@ DCLINK_SS_runPWMCompensation(DCLINK_SS_Handle handle,
                           MATH_ui_vec2 *pUpSoc, MATH_ui_vec2 *pDownSoc)
 {
     DCLINK_SS_Obj *obj = (DCLINK_SS_Obj *)handle;
+    const DCLINK_SS_SortEntry *pSort;
     uint16_t cmp[3];
-    uint16_t swap;
-    uint16_t sector = 0;
+    uint16_t sector;
     MATH_ui_vec3 newCMPA;
     MATH_ui_vec3 newCMPB;
     int16_t dT1,dT2;
     int16_t half_dT1, half_dT2;
     uint16_t pwmPRD = obj->pwmPeriod;
-    uint16_t index0 = 0;
-    uint16_t index1 = 1;
-    uint16_t index2 = 2;
-
-    //
-    // determine the sector of space vector modulation
-    //
-    float32_t Va_tmp = pVab_out->value[1] * 0.5f;
-    float32_t Vb_tmp = MATH_SQRTTHREE_OVER_TWO * pVab_out->value[0];
-
-    // Inverse clarke transformation
-    float32_t Va = pVab_out->value[1];
-    float32_t Vb = -Va_tmp + Vb_tmp;
-    float32_t Vc = -Va_tmp - Vb_tmp;
-
-    if (Va > 0.0f) sector = 1;
-    if (Vb > 0.0f) sector = sector + 2;
-    if (Vc > 0.0f) sector = sector + 4;
-
-    obj->sector_1 = obj->sector;
-    obj->sector = sector;
-
-    //
-    // get EPWMx CMPA values
-    //
-    cmp[0] = pPwmCMPA->value[0];
-    cmp[1] = pPwmCMPA->value[1];
-    cmp[2] = pPwmCMPA->value[2];
+    uint16_t index0, index1, index2;
 
     //
     // find min, mid, max value of PWMx CMPA
     // cmp[0]=min(max_duty), cmp[1]=mid, cmp[2]=max(min_duty)
     //
-    if(cmp[0] > cmp[1])
-    {
-        swap = cmp[0];
-        cmp[0] = cmp[1];
-        cmp[1] = swap;
+    pSort = &DCLINK_SS_sortTable[
+                ((uint16_t)(pPwmCMPA->value[0] > pPwmCMPA->value[1]) << 2) +
+                ((uint16_t)(pPwmCMPA->value[1] > pPwmCMPA->value[2]) << 1) +
+                 (uint16_t)(pPwmCMPA->value[0] > pPwmCMPA->value[2])];
 
-        index0 = 1;
-        index1 = 0;
-    }
-
-    if(cmp[1] > cmp[2])
-    {
-        swap = cmp[1];
-        cmp[1] = cmp[2];
-        cmp[2] = swap;
+    index0 = pSort->index[0];
+    index1 = pSort->index[1];
+    index2 = pSort->index[2];
 
-        index2 = index1;
-        index1 = 2;
-    }
+    //
+    // take the sector of space vector modulation from the compare order, the
+    // sector from the signs of Vab disagrees with the shifted phases when two
+    // compare values round to the same count
+    //
+    sector = DCLINK_SS_sectorTable[pSort->sector];
 
-    if(cmp[0] > cmp[1])
-    {
-        swap = cmp[0];
-        cmp[0] = cmp[1];
-        cmp[1] = swap;
+    obj->sector_1 = obj->sector;
+    obj->sector = sector;
 
-        swap = index1;
-        index1 = index0;
-        index0 = swap;
-    }
+    cmp[0] = pPwmCMPA->value[index0];
+    cmp[1] = pPwmCMPA->value[index1];
+    cmp[2] = pPwmCMPA->value[index2];
 
     //
     // set default newCMPA/B value with new arranged compare value
@@ -814,10 +938,11 @@ DCLINK_SS_runFastPWMCompensation(DCLINK_SS_Handle handle,
                           MATH_ui_vec2 *pADCSoc)
 {
     DCLINK_SS_Obj *obj = (DCLINK_SS_Obj *)handle;
+    const DCLINK_SS_SortEntry *pSort;
     uint16_t cmp[3];
-    uint16_t index0 = 0;        // min cmp/max duty
-    uint16_t index1 = 1;        // mid cmp/mid duty
-    uint16_t index2 = 2;        // max cmp/min duty
+    uint16_t index0;            // min cmp/max duty
+    uint16_t index1;            // mid cmp/mid duty
+    uint16_t index2;            // max cmp/min duty
     int16_t dT1,dT2;
 
     uint16_t pwmPRD = obj->pwmPeriod;
@@ -830,54 +955,17 @@ DCLINK_SS_runFastPWMCompensation(DCLINK_SS_Handle handle,
     cmp[2] = pPWMCMPA->value[2];
 
     // find min, mid, max cmp value of PWMx CMPA
-    if(cmp[0] > cmp[1])         // Ta > Tb
-    {
-        if(cmp[1] > cmp[2])         // Ta > Tb > Tc, Ta is max, Tb is mid, Tc is min
-        {
-            obj->sector = 4;        // sector
-            index0 = 2;             // min cmp/max duty
-            index1 = 1;             // mid cmp/mid duty
-            index2 = 0;             // max cmp/min duty
-        }
-        else if(cmp[0] > cmp[2])    // Ta > Tc > Tb, Ta is max, Tc is mid, Tb is min
-        {
-            obj->sector = 3;        // sector
-            index0 = 1;             // min cmp/max duty
-            index1 = 2;             // mid cmp/mid duty
-            index2 = 0;             // max cmp/min duty
-        }
-        else                        // Tc > Ta > Tb, Tc is max, Ta is mid, Tb is min
-        {
-            obj->sector = 2;        // sector
-            index0 = 1;             // min cmp/max duty
-            index1 = 0;             // mid cmp/mid duty
-            index2 = 2;             // max cmp/min duty
-        }
-    }
-    else                        // Ta < Tb
-    {
-        if(cmp[0] > cmp[2])         // Tb > Ta > Tc, Tb is max, Ta is mid, Tc is min
-        {
-            obj->sector = 5;        // sector
-            index0 = 2;             // min cmp/max duty
-            index1 = 0;             // mid cmp/mid duty
-            index2 = 1;             // max cmp/min duty
-        }
-        else if(cmp[1] > cmp[2])    // Tb > Tc > Ta, Tb is max, Tc is mid, Ta is min
-        {
-            obj->sector = 6;        // sector
-            index0 = 0;             // min cmp/max duty
-            index1 = 2;             // mid cmp/mid duty
-            index2 = 1;             // max cmp/min duty
-        }
-        else                        // Tc > Tb > Ta, Tc is max, Tb is mid, Ta is min
-        {
-            obj->sector = 1;        // sector
-            index0 = 0;             // min cmp/max duty
-            index1 = 1;             // mid cmp/mid duty
-            index2 = 2;             // max cmp/min duty
-        }
-    }
+    //  Ta > Tb > Tc, sector 4     Ta > Tc > Tb, sector 3
+    //  Tc > Ta > Tb, sector 2     Tb > Ta > Tc, sector 5
+    //  Tb > Tc > Ta, sector 6     Tc > Tb > Ta, sector 1
+    pSort = &DCLINK_SS_sortTable[((uint16_t)(cmp[0] > cmp[1]) << 2) +
+                                 ((uint16_t)(cmp[1] > cmp[2]) << 1) +
+                                  (uint16_t)(cmp[0] > cmp[2])];
+
+    obj->sector = pSort->sector;
+    index0 = pSort->index[0];       // min cmp/max duty
+    index1 = pSort->index[1];       // mid cmp/mid duty
+    index2 = pSort->index[2];       // max cmp/min duty
 
     // PWM Phase Shift Compensation with Minimum Voltage Injection
     dT1 = obj->minAvDuration - (cmp[index2] - cmp[index1]);     // max cmp - mid cmp
@@ -895,12 +983,12 @@ DCLINK_SS_runFastPWMCompensation(DCLINK_SS_Handle handle,
             obj->vecArea = 3;
 
             // cmp[index2](min duty/max cmp) is shifted to the left
-            pPWMCMPA->value[index0] = cmp[index0] - dT1;        // left shift
-            pPWMCMPB->value[index0] = cmp[index0] + dT1;        // left shift
+            pPWMCMPA->value[index2] = __max((cmp[index2] - dT1), 1);              // left shift
+            pPWMCMPB->value[index2] = __min((cmp[index2] + dT1), (pwmPRD - 1));   // left shift
 
             // cmp[index0](max duty/min cmp) is shifted to the right
-            pPWMCMPA->value[index2] = cmp[index2] + dT2;        // right shift
-            pPWMCMPB->value[index2] = cmp[index2] - dT2;        // right shift
+            pPWMCMPA->value[index0] = __min((cmp[index0] + dT2), (pwmPRD - 1));   // right shift
+            pPWMCMPB->value[index0] = __max((cmp[index0] - dT2), 1);              // right shift
         }
         else // in case of 6-vector(bar-area), only 1st active vector is unmeasurable
         {
@@ -983,6 +1071,7 @@ DCLINK_SS_runFastCurrentReconstruction(DCLINK_SS_Handle handle,
                                 const MATH_vec2 *pIdc1, const MATH_vec2 *pIdc2)
 {
     DCLINK_SS_Obj *obj = (DCLINK_SS_Obj *)handle;
+    const DCLINK_SS_ReconEntry *pRecon;
     MATH_vec2 Idc;
 
     //Sector    1st_Sample       2nd_Sample
@@ -997,44 +1086,19 @@ DCLINK_SS_runFastCurrentReconstruction(DCLINK_SS_Handle handle,
     Idc.value[0] = (pIdc1->value[0] + pIdc1->value[1]) * 0.5f;
     Idc.value[1] = (pIdc2->value[0] + pIdc2->value[1]) * 0.5f;
 
-    switch(obj->sector_1)
+    if((obj->sector_1 >= 1) && (obj->sector_1 <= 6))
     {
-        case 1:     //  1,1,0 (-Ic)      1,0,0 (+Ia)
-            obj->I_A.value[2] = -Idc.value[0];
-            obj->I_A.value[0] =  Idc.value[1];
-            obj->I_A.value[1] = -obj->I_A.value[0] - obj->I_A.value[2];
-            break;
-        case 2:     // 1,1,0 (-Ic)      0,1,0 (+Ib)
-            obj->I_A.value[2] = -Idc.value[0];
-            obj->I_A.value[1] = Idc.value[1];
-            obj->I_A.value[0] = -obj->I_A.value[1] - obj->I_A.value[2];
-            break;
-        case 3:     //  0,1,1 (-Ia)      0,1,0 (+Ib)
-            obj->I_A.value[0] = -Idc.value[0];
-            obj->I_A.value[1] = Idc.value[1];
-            obj->I_A.value[2] = -obj->I_A.value[0] - obj->I_A.value[1];
-            break;
-        case 4:     //  0,1,1 (-Ia)      0,0,1 (+Ic)
-            obj->I_A.value[0] = -Idc.value[0];
-            obj->I_A.value[2] = Idc.value[1];
-            obj->I_A.value[1] = -obj->I_A.value[0] - obj->I_A.value[2];
-            break;
-        case 5:     //  1,0,1 (-Ib)      0,0,1 (+Ic)
-            obj->I_A.value[1] = -Idc.value[0];
-            obj->I_A.value[2] = Idc.value[1];
-            obj->I_A.value[0] = -obj->I_A.value[1] - obj->I_A.value[2];
-            break;
-        case 6:     //  1,0,1 (-Ib)      1,0,0 (+Ia)
-            obj->I_A.value[1] = -Idc.value[0];
-            obj->I_A.value[0] = Idc.value[1];
-            obj->I_A.value[2] = -obj->I_A.value[0] - obj->I_A.value[1];
-            break;
-        default:
-            break;
+        pRecon = &DCLINK_SS_fastReconTable[obj->sector_1];
+
+        obj->I_A.value[pRecon->index[0]] = -Idc.value[0];
+        obj->I_A.value[pRecon->index[1]] = Idc.value[1];
+        obj->I_A.value[pRecon->index[2]] =
+                -obj->I_A.value[pRecon->index[1]] -
+                 obj->I_A.value[pRecon->index[0]];
     }
 
     return;
-} // end of DCLINK_SS_runCurrentReconstruction() function
+} // end of DCLINK_SS_runFastCurrentReconstruction() function
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -52,6 +52,77 @@
 // **************************************************************************
 // the globals
 
+//
+// Comparison code = (cmp[0] > cmp[1]) * 4 + (cmp[1] > cmp[2]) * 2 +
+//                   (cmp[0] > cmp[2])
+// codes 1 and 6 can't occur and follow the first comparison that decides
+//
+const DCLINK_SS_SortEntry DCLINK_SS_sortTable[8] =
+{
+    {1, {0, 1, 2}},     // code 0, Tc >= Tb >= Ta
+    {5, {2, 0, 1}},     // code 1
+    {6, {0, 2, 1}},     // code 2, Tb > Tc >= Ta
+    {5, {2, 0, 1}},     // code 3, Tb >= Ta > Tc
+    {2, {1, 0, 2}},     // code 4, Tc >= Ta > Tb
+    {3, {1, 2, 0}},     // code 5, Ta > Tc >= Tb
+    {4, {2, 1, 0}},     // code 6
+    {4, {2, 1, 0}}      // code 7, Ta > Tb > Tc
+};
+
+//
+// The sector of the sign of the rotated phase voltages, it holds the same
+// 1st/2nd sample phases in DCLINK_SS_reconTable[] as the sorted sector does
+// in DCLINK_SS_fastReconTable[]
+//
+const uint16_t DCLINK_SS_sectorTable[8] =
+{
+    0,                  // sector 0, not used
+    3,                  // sector 1, Tc >= Tb >= Ta
+    1,                  // sector 2, Tc >= Ta > Tb
+    5,                  // sector 3, Ta > Tc >= Tb
+    4,                  // sector 4, Ta > Tb > Tc
+    6,                  // sector 5, Tb >= Ta > Tc
+    2,                  // sector 6, Tb > Tc >= Ta
+    0                   // sector 7, not used
+};
+
+//
+// Sector    1st_Sample       2nd_Sample
+//
+const DCLINK_SS_ReconEntry DCLINK_SS_reconTable[8] =
+{
+    {{0, 1, 2}},        // sector 0, not used
+    {{2, 1, 0}},        // sector 1, 1,1,0 (-Ic)      0,1,0 (+Ib)
+    {{1, 0, 2}},        // sector 2, 1,0,1 (-Ib)      1,0,0 (+Ia)
+    {{2, 0, 1}},        // sector 3, 1,1,0 (-Ic)      1,0,0 (+Ia)
+    {{0, 2, 1}},        // sector 4, 0,1,1 (-Ia)      0,0,1 (+Ic)
+    {{0, 1, 2}},        // sector 5, 0,1,1 (-Ia)      0,1,0 (+Ib)
+    {{1, 2, 0}},        // sector 6, 1,0,1 (-Ib)      0,0,1 (+Ic)
+    {{0, 1, 2}}         // sector 7, not used
+};
+
+const DCLINK_SS_ReconEntry DCLINK_SS_fastReconTable[8] =
+{
+    {{0, 1, 2}},        // sector 0, not used
+    {{2, 0, 1}},        // sector 1, 1,1,0 (-Ic)      1,0,0 (+Ia)
+    {{2, 1, 0}},        // sector 2, 1,1,0 (-Ic)      0,1,0 (+Ib)
+    {{0, 1, 2}},        // sector 3, 0,1,1 (-Ia)      0,1,0 (+Ib)
+    {{0, 2, 1}},        // sector 4, 0,1,1 (-Ia)      0,0,1 (+Ic)
+    {{1, 2, 0}},        // sector 5, 1,0,1 (-Ib)      0,0,1 (+Ic)
+    {{1, 0, 2}},        // sector 6, 1,0,1 (-Ib)      1,0,0 (+Ia)
+    {{0, 1, 2}}         // sector 7, not used
+};
+
+//
+// {up count weight, down count weight}
+//
+const float32_t DCLINK_SS_sampleWeight[3][2] =
+{
+    {0.0f, 1.0f},       // measurement vector is on down count
+    {1.0f, 0.0f},       // measurement vector is on up count
+    {0.5f, 0.5f}        // measurement vector is on up and down count
+};
+
 
 // **************************************************************************
 // the functions
@@ -120,6 +191,295 @@ DCLINK_SS_setInitialConditions(DCLINK_SS_Handle handle,
 
     return;
 } // end of DCLINK_SS_setInitialConditions() function
+
+#ifdef DCLINK_SS_SWEEP
+//*****************************************************************************
+//
+// DCLINK_SS_computeShuntCurrent
+//
+//*****************************************************************************
+float32_t
+DCLINK_SS_computeShuntCurrent(const MATH_ui_vec3 *pPwmCMPA,
+                              const MATH_ui_vec3 *pPwmCMPB,
+                              const MATH_vec3 *pI_A,
+                              const uint16_t socCount, const bool flagUpCount)
+{
+    const MATH_ui_vec3 *pCmp = (flagUpCount == true) ? pPwmCMPA : pPwmCMPB;
+    float32_t Idc_A = 0.0f;
+    uint16_t cnt;
+
+    for(cnt = 0; cnt < 3; cnt++)
+    {
+        if(socCount >= pCmp->value[cnt])
+        {
+            Idc_A += pI_A->value[cnt];
+        }
+    }
+
+    return(Idc_A);
+} // end of DCLINK_SS_computeShuntCurrent() function
+
+//*****************************************************************************
+//
+// DCLINK_SS_checkSampleWindow
+//
+//*****************************************************************************
+bool
+DCLINK_SS_checkSampleWindow(DCLINK_SS_Handle handle,
+                            const MATH_ui_vec3 *pPwmCMPA,
+                            const MATH_ui_vec3 *pPwmCMPB,
+                            const uint16_t socCount, const bool flagUpCount)
+{
+    DCLINK_SS_Obj *obj = (DCLINK_SS_Obj *)handle;
+    int32_t period = (int32_t)obj->pwmPeriod * 2;
+    int32_t timeStart, timeEnd, timeEdge;
+    uint16_t cnt;
+
+    //
+    // time in counter ticks from the start of the up count
+    //
+    timeStart = (flagUpCount == true) ?
+                (int32_t)socCount : (period - (int32_t)socCount);
+    timeEnd = timeStart + (int32_t)obj->sampleHoldTime;
+    timeStart = timeStart - (int32_t)obj->sampleDelay;
+
+    for(cnt = 0; cnt < 3; cnt++)
+    {
+        // switching edge on up count
+        timeEdge = (int32_t)pPwmCMPA->value[cnt];
+
+        if((timeEdge > timeStart) && (timeEdge <= timeEnd))
+        {
+            return(false);
+        }
+
+        // switching edge on down count
+        timeEdge = period - (int32_t)pPwmCMPB->value[cnt];
+
+        if((timeEdge > timeStart) && (timeEdge <= timeEnd))
+        {
+            return(false);
+        }
+    }
+
+    return(true);
+} // end of DCLINK_SS_checkSampleWindow() function
+
+//*****************************************************************************
+//
+// DCLINK_SS_runSamplingSweep
+//
+//*****************************************************************************
+void
+DCLINK_SS_runSamplingSweep(DCLINK_SS_Handle handle,
+                           const DCLINK_SS_SweepPath_e path,
+                           const float32_t modMax, const uint16_t numMod,
+                           const uint16_t numAngle, const float32_t Is_A,
+                           const float32_t phi_rad,
+                           DCLINK_SS_SweepResult *pResult)
+{
+    DCLINK_SS_Obj sweepObj = *(DCLINK_SS_Obj *)handle;
+    DCLINK_SS_Obj *obj = &sweepObj;
+    DCLINK_SS_Handle sweepHandle = (DCLINK_SS_Handle)&sweepObj;
+    const float32_t *pWeight;
+    float32_t pwmPRD = (float32_t)obj->pwmPeriod;
+    float32_t mod, modStep, angleStep_rad;
+    float32_t cosAngle, sinAngle, cosStep, sinStep, cosPhi, sinPhi, temp;
+    float32_t Vph[3], Vmax, Vmin, Vcom, duty, error_A;
+    float32_t errorSqSum = 0.0f;
+    uint32_t count, countSum = 0;
+    MATH_vec3 I_A;
+    MATH_vec2 Vab_out;
+    MATH_vec2 Idc1, Idc2;
+    MATH_ui_vec3 cmpIn, pwmCMPA, pwmCMPB;
+    MATH_ui_vec2 upSoc, downSoc;
+    uint16_t cntMod, cntAngle, cnt, cycle, mode;
+
+    pResult->errorMax_A = 0.0f;
+    pResult->errorRms_A = 0.0f;
+    pResult->errorMaxMod = 0.0f;
+    pResult->countMean = 0.0f;
+    pResult->numPoints = 0;
+    pResult->numWindowFail = 0;
+
+    // numMod points up to and including modMax
+    modStep = modMax / (float32_t)numMod;
+
+    //
+    // the voltage phasor is turned by the angle step, so the sweep computes
+    // the sine and cosine only once and not at each operating point
+    //
+    angleStep_rad = MATH_TWO_PI / (float32_t)numAngle;
+    cosStep = cosf(angleStep_rad);
+    sinStep = sinf(angleStep_rad);
+    cosPhi = cosf(phi_rad);
+    sinPhi = sinf(phi_rad);
+
+    cosAngle = 1.0f;
+    sinAngle = 0.0f;
+
+    for(cntAngle = 0; cntAngle < numAngle; cntAngle++)
+    {
+        //
+        // phase voltages and currents of the phasors at 0, -120 and +120
+        // degrees, a phase is on while the counter is at or above its
+        // compare value
+        //
+        Vph[0] = cosAngle;
+        Vph[1] = -0.5f * cosAngle + MATH_SQRTTHREE_OVER_TWO * sinAngle;
+        Vph[2] = -0.5f * cosAngle - MATH_SQRTTHREE_OVER_TWO * sinAngle;
+
+        temp = cosAngle * cosPhi - sinAngle * sinPhi;
+        I_A.value[0] = Is_A * temp;
+        I_A.value[1] = Is_A * (-0.5f * temp + MATH_SQRTTHREE_OVER_TWO *
+                               (sinAngle * cosPhi + cosAngle * sinPhi));
+        I_A.value[2] = -I_A.value[0] - I_A.value[1];
+
+        for(cntMod = 0; cntMod < numMod; cntMod++)
+        {
+            mod = modStep * (float32_t)(cntMod + 1);
+
+            //
+            // space vector compare values with min-max injection
+            //
+            Vmax = MATH_max(MATH_max(Vph[0], Vph[1]), Vph[2]);
+            Vmin = MATH_min(MATH_min(Vph[0], Vph[1]), Vph[2]);
+            Vcom = -0.5f * (Vmax + Vmin);
+
+            for(cnt = 0; cnt < 3; cnt++)
+            {
+                duty = MATH_sat(0.5f + 0.5f * mod * (Vph[cnt] + Vcom),
+                                1.0f, 0.0f);
+                cmpIn.value[cnt] = (uint16_t)(pwmPRD * (1.0f - duty) + 0.5f);
+            }
+
+            Vab_out.value[0] = 0.5f * mod * cosAngle;
+            Vab_out.value[1] = 0.5f * mod * sinAngle;
+
+            // the reconstruction uses the states of the previous cycle
+            for(cycle = 0; cycle < 2; cycle++)
+            {
+                pwmCMPA = cmpIn;
+                pwmCMPB = cmpIn;
+
+                count = DCLINK_SS_SWEEP_GET_COUNT();
+
+                if(path == DCLINK_SS_SWEEP_FAST)
+                {
+                    DCLINK_SS_runFastPWMCompensation(sweepHandle, &pwmCMPA,
+                                                     &pwmCMPB, &downSoc);
+                }
+                else
+                {
+                    DCLINK_SS_runPWMCompensation(sweepHandle, &Vab_out, 1.0f,
+                                                 &pwmCMPA, &pwmCMPB,
+                                                 &upSoc, &downSoc);
+                }
+            }
+
+            countSum += (uint32_t)(DCLINK_SS_SWEEP_GET_COUNT() - count);
+
+            if(path == DCLINK_SS_SWEEP_FAST)
+            {
+                // both conversions of a trigger see the same shunt current
+                Idc1.value[0] = DCLINK_SS_computeShuntCurrent(&pwmCMPA,
+                                    &pwmCMPB, &I_A, downSoc.value[0], false);
+                Idc1.value[1] = Idc1.value[0];
+                Idc2.value[0] = DCLINK_SS_computeShuntCurrent(&pwmCMPA,
+                                    &pwmCMPB, &I_A, downSoc.value[1], false);
+                Idc2.value[1] = Idc2.value[0];
+
+                for(cnt = 0; cnt < 2; cnt++)
+                {
+                    if(DCLINK_SS_checkSampleWindow(sweepHandle, &pwmCMPA,
+                                &pwmCMPB, downSoc.value[cnt], false) == false)
+                    {
+                        pResult->numWindowFail++;
+                    }
+                }
+
+                count = DCLINK_SS_SWEEP_GET_COUNT();
+
+                DCLINK_SS_runFastCurrentReconstruction(sweepHandle,
+                                                       &Idc1, &Idc2);
+            }
+            else
+            {
+                mode = ((obj->flagEnableFullSample == true) &&
+                        (obj->vecArea_1 == 0)) ? 2 : (obj->flag_SST_1 != 0);
+                pWeight = &DCLINK_SS_sampleWeight[mode][0];
+
+                for(cnt = 0; cnt < 2; cnt++)
+                {
+                    Idc1.value[cnt] = DCLINK_SS_computeShuntCurrent(&pwmCMPA,
+                                    &pwmCMPB, &I_A, upSoc.value[cnt], true);
+                    Idc2.value[cnt] = DCLINK_SS_computeShuntCurrent(&pwmCMPA,
+                                    &pwmCMPB, &I_A, downSoc.value[cnt], false);
+
+                    if((pWeight[0] > 0.0f) &&
+                       (DCLINK_SS_checkSampleWindow(sweepHandle, &pwmCMPA,
+                                &pwmCMPB, upSoc.value[cnt], true) == false))
+                    {
+                        pResult->numWindowFail++;
+                    }
+
+                    if((pWeight[1] > 0.0f) &&
+                       (DCLINK_SS_checkSampleWindow(sweepHandle, &pwmCMPA,
+                                &pwmCMPB, downSoc.value[cnt], false) == false))
+                    {
+                        pResult->numWindowFail++;
+                    }
+                }
+
+                count = DCLINK_SS_SWEEP_GET_COUNT();
+
+                DCLINK_SS_runCurrentReconstruction(sweepHandle, &Idc1, &Idc2);
+            }
+
+            countSum += (uint32_t)(DCLINK_SS_SWEEP_GET_COUNT() - count);
+
+            for(cnt = 0; cnt < 3; cnt++)
+            {
+                error_A = MATH_abs(obj->I_A.value[cnt] - I_A.value[cnt]);
+                errorSqSum += error_A * error_A;
+
+                if(error_A > pResult->errorMax_A)
+                {
+                    pResult->errorMax_A = error_A;
+                    pResult->errorMaxMod = mod;
+                }
+            }
+
+            pResult->numPoints++;
+        }
+
+        //
+        // turn the voltage phasor by one angle step and pull its length back
+        // to one, so the rounding does not build up over the turn
+        //
+        temp = cosAngle * cosStep - sinAngle * sinStep;
+        sinAngle = sinAngle * cosStep + cosAngle * sinStep;
+        cosAngle = temp;
+
+        temp = 1.5f - 0.5f * (cosAngle * cosAngle + sinAngle * sinAngle);
+        cosAngle *= temp;
+        sinAngle *= temp;
+    }
+
+    if(pResult->numPoints > 0)
+    {
+        pResult->errorRms_A = __sqrt(errorSqSum /
+                                     (3.0f * (float32_t)pResult->numPoints));
+
+        // the second cycle of the compensation and the reconstruction
+        pResult->countMean = (float32_t)countSum /
+                             (float32_t)pResult->numPoints;
+    }
+
+    return;
+} // end of DCLINK_SS_runSamplingSweep() function
+#endif  //DCLINK_SS_SWEEP
+
 //
 // end of file
 //
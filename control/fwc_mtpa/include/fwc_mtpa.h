@@ -0,0 +1,295 @@
+//#############################################################################
+//
+// FILE:   fwc_mtpa.h
+//
+// TITLE:  C28x Combined field weakening and MTPA current angle library (floating point)
+//
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+#ifndef FWC_MTPA_H
+#define FWC_MTPA_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! \defgroup FWC_MTPA FWC_MTPA
+//! @{
+//
+//*****************************************************************************
+
+#include "libraries/math/include/math.h"
+
+#ifdef __TMS320C28XX_CLA__
+#include "libraries/math/include/CLAmath.h"
+#else
+#include <math.h>
+#endif
+
+#include "fwc.h"
+#include "mtpa.h"
+
+//*****************************************************************************
+//
+//! \brief Defines the combined field weakening and MTPA (FWC_MTPA) object
+//!
+//! The stage replaces the FWC_computeCurrentAngle() and
+//! MTPA_computeCurrentAngle() chain of the application. The output voltage
+//! magnitude is computed once, MTPA is evaluated in the cosine domain and the
+//! d/q-axis current references are taken from the MTPA solution directly when
+//! MTPA sets the angle, sin/cos are only evaluated when FWC sets the angle.
+//
+//*****************************************************************************
+typedef struct _FWC_MTPA_Obj_
+{
+    FWC_Handle  fwcHandle;          //!< the handle for the FWC
+    FWC_Obj     fwc;                //!< the FWC object
+    MTPA_Handle mtpaHandle;         //!< the handle for the MTPA
+    MTPA_Obj    mtpa;               //!< the MTPA object
+
+    MATH_Vec2 Idq_ref_A;            //!< the d/q-axis current reference
+    float32_t angleCurrent_rad;     //!< the stator current phase angle
+    float32_t Vs_V;                 //!< the output voltage vector magnitude
+    bool      flagFWCActive;        //!< a flag indicating FWC sets the angle
+} FWC_MTPA_Obj;
+
+//*****************************************************************************
+//
+//! \brief Defines the FWC_MTPA handle
+//
+//*****************************************************************************
+typedef struct _FWC_MTPA_Obj_ *FWC_MTPA_Handle;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs
+//
+//*****************************************************************************
+
+//! \brief     Gets the FWC handle
+//! \param[in] handle  The FWC_MTPA handle
+//! \return    The FWC handle, configured with the FWC APIs
+static inline FWC_Handle FWC_MTPA_getFWCHandle(FWC_MTPA_Handle handle)
+{
+    FWC_MTPA_Obj *obj = (FWC_MTPA_Obj *)handle;
+
+    return(obj->fwcHandle);
+} // end of FWC_MTPA_getFWCHandle() function
+
+
+//! \brief     Gets the MTPA handle
+//! \param[in] handle  The FWC_MTPA handle
+//! \return    The MTPA handle, configured with the MTPA APIs
+static inline MTPA_Handle FWC_MTPA_getMTPAHandle(FWC_MTPA_Handle handle)
+{
+    FWC_MTPA_Obj *obj = (FWC_MTPA_Obj *)handle;
+
+    return(obj->mtpaHandle);
+} // end of FWC_MTPA_getMTPAHandle() function
+
+
+//! \brief     Gets the stator current phase angle value (angleCurrent_rad)
+//! \param[in] handle  The FWC_MTPA handle
+//! \return    The stator current phase angle value, rad
+static inline float32_t FWC_MTPA_getCurrentAngle_rad(FWC_MTPA_Handle handle)
+{
+    FWC_MTPA_Obj *obj = (FWC_MTPA_Obj *)handle;
+
+    return(obj->angleCurrent_rad);
+} // end of FWC_MTPA_getCurrentAngle_rad() function
+
+
+//! \brief     Gets the direct current reference value (Id_ref_A)
+//! \param[in] handle  The FWC_MTPA handle
+//! \return    The direct current reference value, A
+static inline float32_t FWC_MTPA_getId_ref_A(FWC_MTPA_Handle handle)
+{
+    FWC_MTPA_Obj *obj = (FWC_MTPA_Obj *)handle;
+
+    return(obj->Idq_ref_A.value[0]);
+} // end of FWC_MTPA_getId_ref_A() function
+
+
+//! \brief     Gets the quadrature current reference value (Iq_ref_A)
+//! \param[in] handle  The FWC_MTPA handle
+//! \return    The quadrature current reference value, A
+static inline float32_t FWC_MTPA_getIq_ref_A(FWC_MTPA_Handle handle)
+{
+    FWC_MTPA_Obj *obj = (FWC_MTPA_Obj *)handle;
+
+    return(obj->Idq_ref_A.value[1]);
+} // end of FWC_MTPA_getIq_ref_A() function
+
+
+//! \brief     Gets the output voltage vector magnitude computed by the stage
+//! \param[in] handle  The FWC_MTPA handle
+//! \return    The output voltage vector magnitude, V
+static inline float32_t FWC_MTPA_getVs_V(FWC_MTPA_Handle handle)
+{
+    FWC_MTPA_Obj *obj = (FWC_MTPA_Obj *)handle;
+
+    return(obj->Vs_V);
+} // end of FWC_MTPA_getVs_V() function
+
+
+//! \brief     Gets the flag indicating the FWC sets the current angle
+//! \param[in] handle  The FWC_MTPA handle
+//! \return    The FWC active flag
+static inline bool FWC_MTPA_getFlagFWCActive(FWC_MTPA_Handle handle)
+{
+    FWC_MTPA_Obj *obj = (FWC_MTPA_Obj *)handle;
+
+    return(obj->flagFWCActive);
+} // end of FWC_MTPA_getFlagFWCActive() function
+
+
+//! \brief     Initializes the FWC_MTPA module
+//! \param[in] pMemory   A pointer to the memory for the FWC_MTPA object
+//! \param[in] numBytes  The number of bytes allocated for the FWC_MTPA object
+//! \return The FWC_MTPA object handle
+extern FWC_MTPA_Handle FWC_MTPA_init(void *pMemory, const size_t numBytes);
+
+
+//! \brief     Runs the combined field weakening and MTPA stage, gives the
+//!            same current angle and d/q-axis current references as
+//!            FWC_computeCurrentAngle() and MTPA_computeCurrentAngle() with
+//!            the larger of both angles applied to Is_ref_A
+//! \param[in] handle    The FWC_MTPA handle
+//! \param[in] pVdq_V    The pointer to the d/q-axis output voltage vector, V
+//! \param[in] VsRef_V   The reference voltage vector magnitude, V
+//! \param[in] Is_ref_A  The stator current reference value, A
+//! \return    None
+static inline void FWC_MTPA_run(FWC_MTPA_Handle handle,
+                                const MATH_Vec2 *pVdq_V,
+                                const float32_t VsRef_V,
+                                const float32_t Is_ref_A)
+{
+    FWC_MTPA_Obj *obj = (FWC_MTPA_Obj *)handle;
+    MTPA_Obj *mtpa = &obj->mtpa;
+    float32_t Is_A = MATH_abs(Is_ref_A);
+    float32_t VsSq_V2 = (pVdq_V->value[0] * pVdq_V->value[0]) +
+                        (pVdq_V->value[1] * pVdq_V->value[1]);
+    float32_t cosMTPA = 0.0f;
+    float32_t angleMTPA_rad = MATH_PI_OVER_TWO;
+    float32_t angleFWC_rad;
+
+#ifdef __TMS320C28XX_CLA__
+    obj->Vs_V = CLAsqrt(VsSq_V2);
+#else
+    obj->Vs_V = sqrtf(VsSq_V2);
+#endif
+
+    FWC_computeCurrentAngle(obj->fwcHandle, obj->Vs_V, VsRef_V);
+    angleFWC_rad = FWC_getCurrentAngle_rad(obj->fwcHandle);
+
+    // MTPA in the cosine domain, cos(angle) = g - sqrt(g^2 + 0.5)
+    mtpa->Is_ref_A = Is_A;
+
+    if((MTPA_getFlagEnable(obj->mtpaHandle) == true) &&
+       (mtpa->kconst != 0.0f) && (Is_A != 0.0f))
+    {
+        mtpa->gconst = mtpa->kconst / Is_A;
+
+#ifdef __TMS320C28XX_CLA__
+        cosMTPA = mtpa->gconst - CLAsqrt(mtpa->gconst * mtpa->gconst + 0.5f);
+        angleMTPA_rad = CLAacos(cosMTPA);
+#else
+        cosMTPA = mtpa->gconst - sqrtf(mtpa->gconst * mtpa->gconst + 0.5f);
+        angleMTPA_rad = acosf(cosMTPA);
+#endif
+    }
+
+    mtpa->angleCurrent_rad = angleMTPA_rad;
+
+    if(angleFWC_rad > angleMTPA_rad)
+    {
+        obj->flagFWCActive = true;
+        obj->angleCurrent_rad = angleFWC_rad;
+
+#ifdef __TMS320C28XX_CLA__
+        obj->Idq_ref_A.value[0] = Is_ref_A * CLAcos_inline(angleFWC_rad);
+        obj->Idq_ref_A.value[1] = Is_ref_A * CLAsin_inline(angleFWC_rad);
+#else
+        obj->Idq_ref_A.value[0] = Is_ref_A * cosf(angleFWC_rad);
+        obj->Idq_ref_A.value[1] = Is_ref_A * sinf(angleFWC_rad);
+#endif
+    }
+    else
+    {
+        // take the MTPA solution directly, no sin/cos is needed
+        obj->flagFWCActive = false;
+        obj->angleCurrent_rad = angleMTPA_rad;
+
+        obj->Idq_ref_A.value[0] = Is_ref_A * cosMTPA;
+
+#ifdef __TMS320C28XX_CLA__
+        obj->Idq_ref_A.value[1] = Is_ref_A *
+                                  CLAsqrt(1.0f - (cosMTPA * cosMTPA));
+#else
+        obj->Idq_ref_A.value[1] = Is_ref_A * sqrtf(1.0f - (cosMTPA * cosMTPA));
+#endif
+    }
+
+    mtpa->Idq_ref_A.value[0] = obj->Idq_ref_A.value[0];
+    mtpa->Idq_ref_A.value[1] = obj->Idq_ref_A.value[1];
+
+    return;
+} // end of FWC_MTPA_run() function
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FWC_MTPA_H
@@ -0,0 +1,84 @@
+//#############################################################################
+//
+// FILE:   fwc_mtpa.c
+//
+// TITLE:  C28x Combined field weakening and MTPA current angle library (floating point)
+//
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+#include "fwc_mtpa.h"
+
+// ****************************************************************************
+//
+// FWC_MTPA_init
+//
+// ****************************************************************************
+FWC_MTPA_Handle FWC_MTPA_init(void *pMemory, const size_t numBytes)
+{
+    FWC_MTPA_Handle handle;
+    FWC_MTPA_Obj *obj;
+
+    if((int16_t)numBytes < (int16_t)sizeof(FWC_MTPA_Obj))
+    {
+        return((FWC_MTPA_Handle)NULL);
+    }
+
+    //
+    // assign the handle
+    //
+    handle = (FWC_MTPA_Handle)pMemory;
+
+    //
+    // Assign the object
+    //
+    obj = (FWC_MTPA_Obj *)handle;
+
+    //
+    // Initialize the FWC and MTPA modules
+    //
+    obj->fwcHandle = FWC_init(&obj->fwc, sizeof(obj->fwc));
+    obj->mtpaHandle = MTPA_init(&obj->mtpa, sizeof(obj->mtpa));
+
+    obj->Idq_ref_A.value[0] = 0.0f;
+    obj->Idq_ref_A.value[1] = 0.0f;
+    obj->angleCurrent_rad = MATH_PI_OVER_TWO;
+    obj->Vs_V = 0.0f;
+    obj->flagFWCActive = false;
+
+    return(handle);
+} // end of FWC_MTPA_init() function
+
+//
+// end of file
+//
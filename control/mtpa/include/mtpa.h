@@ -80,6 +80,12 @@ extern "C"
 //! \brief Defines the current delta of LUT for Lq, A
 #define MTPA_LUT_DELTA_CURRENT_LD_A      0.5
 
+//! \brief Defines the number of stator current points of the MTPA surface
+#define MTPA_SURF_IS_NUM                 17
+
+//! \brief Defines the number of motor constant points of the MTPA surface
+#define MTPA_SURF_K_NUM                  5
+
 //*****************************************************************************
 //
 //! \brief Defines the MTPA object
@@ -97,9 +103,45 @@ typedef struct _MTPA_Obj_
     uint16_t  indexMax_Ld;          //!< the Is detla for Ld lookup table
     uint16_t  indexMax_Lq;          //!< the Is detla for Lq lookup table
     bool      flagEnable;           //!< a flag to enable the controller
+    bool      flagSurfaceLimit;     //!< the last surface lookup left the grid
 } MTPA_Obj;
 
 
+//*****************************************************************************
+//
+//! \brief Defines the MTPA reference surface
+//!
+//! The surface holds the MTPA solution on a uniform grid of the stator
+//! current reference (0 ~ IsMax_A) and the motor constant kconst
+//! (kconstMin_A ~ kconstMax_A), kconst moves with the operating point when
+//! Ld/Lq are updated from the inductance lookup tables. The grid is built once
+//! by MTPA_buildSurface() and is evaluated with a bilinear interpolation.
+//! Above IsMax_A the last cell is extrapolated, so the current is never
+//! capped, and kconst is held at the grid edge; both set flagSurfaceLimit.
+//
+//*****************************************************************************
+typedef struct _MTPA_Surface_
+{
+    float32_t Id_A[MTPA_SURF_K_NUM][MTPA_SURF_IS_NUM];      //!< Id nodes, A
+    float32_t Iq_A[MTPA_SURF_K_NUM][MTPA_SURF_IS_NUM];      //!< Iq nodes, A
+    float32_t angle_rad[MTPA_SURF_K_NUM][MTPA_SURF_IS_NUM]; //!< angle nodes
+    float32_t IsMax_A;              //!< the maximum stator current of the grid
+    float32_t kconstMin_A;          //!< the minimum motor constant of the grid
+    float32_t kconstMax_A;          //!< the maximum motor constant of the grid
+    float32_t IsStepInv_1oA;        //!< the inverse of the stator current step
+    float32_t kconstStepInv_1oA;    //!< the inverse of the motor constant step
+    float32_t errorMaxIdq_A;        //!< the maximum Id/Iq error of the grid
+    float32_t errorMaxAngle_rad;    //!< the maximum angle error of the grid
+} MTPA_Surface;
+
+//*****************************************************************************
+//
+//! \brief Defines the MTPA surface handle
+//
+//*****************************************************************************
+typedef struct _MTPA_Surface_ *MTPA_SurfaceHandle;
+
+
 //! \brief Defines the Ld array
 extern const float32_t MTPA_Ld_tableData_H[MTPA_LUT_INDEX_LD_MAX + 1];
 
@@ -129,6 +171,24 @@ extern void MTPA_computeParameters(MTPA_Handle handle,
                                    const float32_t Ls_q_H,
                                    const float32_t flux_Wb);
 
+//! \brief     Builds the MTPA reference surface from the analytic solution
+//!            It is called once at initialization, not in the control loop
+//! \param[in] surfHandle   The MTPA surface handle
+//! \param[in] IsMax_A      The maximum stator current of the grid, A
+//! \param[in] kconstMin_A  The minimum motor constant of the grid, A
+//! \param[in] kconstMax_A  The maximum motor constant of the grid, A
+extern void MTPA_buildSurface(MTPA_SurfaceHandle surfHandle,
+                              const float32_t IsMax_A,
+                              const float32_t kconstMin_A,
+                              const float32_t kconstMax_A);
+
+//! \brief     Computes the maximum interpolation error of the MTPA surface
+//!            against the analytic solution, the errors are evaluated on the
+//!            cell centers and edge midpoints and are saved into the surface
+//! \param[in] surfHandle   The MTPA surface handle
+//! \return    The maximum Id/Iq error, A
+extern float32_t MTPA_computeSurfaceError(MTPA_SurfaceHandle surfHandle);
+
 //! \brief     Disables the MTPA
 //! \param[in] handle  The maximum torque per ampere (MTPA) handle
 static inline void MTPA_disable(MTPA_Handle handle)
@@ -208,6 +268,18 @@ static inline bool MTPA_getFlagEnable(MTPA_Handle handle)
 } // end of MTPA_getFlagEnable() function
 
 
+//! \brief     Gets the surface limit flag of the last surface lookup
+//! \param[in] handle  The maximum torque per ampere (MTPA) handle
+//! \return    true when the last lookup extrapolated beyond IsMax_A or held
+//!            kconst at the grid edge
+static inline bool MTPA_getFlagSurfaceLimit(MTPA_Handle handle)
+{
+    MTPA_Obj *obj = (MTPA_Obj *)handle;
+
+    return(obj->flagSurfaceLimit);
+} // end of MTPA_getFlagSurfaceLimit() function
+
+
 //! \brief     Gets the direct current reference value (Id_ref_A)
 //! \param[in] handle  The maximum torque per ampere (MTPA) handle
 //! \return    The direct reference reference current, A
@@ -424,6 +496,176 @@ MTPA_computeCurrentAngle(MTPA_Handle handle, const float32_t Is_ref_A)
 } // end of MTPA_computeCurrentAngle() function
 
 
+//*****************************************************************************
+//! \brief     Interpolates one table of the MTPA surface
+//! \param[in] table   The surface table
+//! \param[in] indexIs The stator current index of the lower node
+//! \param[in] indexK  The motor constant index of the lower node
+//! \param[in] fracIs  The stator current fraction between the nodes
+//! \param[in] fracK   The motor constant fraction between the nodes
+//! \return    The interpolated value
+//*****************************************************************************
+static inline float32_t
+MTPA_interpSurface(const float32_t table[MTPA_SURF_K_NUM][MTPA_SURF_IS_NUM],
+                   const uint16_t indexIs, const uint16_t indexK,
+                   const float32_t fracIs, const float32_t fracK)
+{
+    float32_t valueLow, valueHigh;
+
+    valueLow = table[indexK][indexIs] +
+               fracIs * (table[indexK][indexIs + 1] - table[indexK][indexIs]);
+
+    valueHigh = table[indexK + 1][indexIs] +
+                fracIs * (table[indexK + 1][indexIs + 1] -
+                          table[indexK + 1][indexIs]);
+
+    return(valueLow + fracK * (valueHigh - valueLow));
+} // end of MTPA_interpSurface() function
+
+
+//*****************************************************************************
+//! \brief     Finds the surface cell and fractions for an operating point
+//! \param[in] surfHandle  The MTPA surface handle
+//! \param[in] Is_A        The stator current reference magnitude, A
+//! \param[in] kconst_A    The motor constant, A
+//! \param[out] pIndexIs   The stator current index of the lower node
+//! \param[out] pIndexK    The motor constant index of the lower node
+//! \param[out] pFracIs    The stator current fraction between the nodes,
+//!                        above 1 when Is_A is beyond IsMax_A (extrapolation)
+//! \param[out] pFracK     The motor constant fraction between the nodes
+//! \return    true when the operating point is outside of the grid
+//*****************************************************************************
+static inline bool
+MTPA_findSurfaceCell(MTPA_SurfaceHandle surfHandle,
+                     const float32_t Is_A, const float32_t kconst_A,
+                     uint16_t *pIndexIs, uint16_t *pIndexK,
+                     float32_t *pFracIs, float32_t *pFracK)
+{
+    MTPA_Surface *surf = (MTPA_Surface *)surfHandle;
+
+    // no upper limit on the current, the last cell extrapolates
+    float32_t posIs = MATH_max(Is_A * surf->IsStepInv_1oA, 0.0f);
+
+    float32_t posKRaw = (kconst_A - surf->kconstMin_A) * surf->kconstStepInv_1oA;
+    float32_t posK = MATH_sat(posKRaw, (float32_t)(MTPA_SURF_K_NUM - 1), 0.0f);
+
+    uint16_t indexIs = (uint16_t)posIs;
+    uint16_t indexK = (uint16_t)posK;
+
+    // the last node is reached with the fraction of the last cell
+    indexIs = (indexIs > (MTPA_SURF_IS_NUM - 2)) ?
+                                        (MTPA_SURF_IS_NUM - 2) : indexIs;
+    indexK = (indexK > (MTPA_SURF_K_NUM - 2)) ? (MTPA_SURF_K_NUM - 2) : indexK;
+
+    *pIndexIs = indexIs;
+    *pIndexK = indexK;
+    *pFracIs = posIs - (float32_t)indexIs;
+    *pFracK = posK - (float32_t)indexK;
+
+    return((posIs > (float32_t)(MTPA_SURF_IS_NUM - 1)) || (posKRaw != posK));
+} // end of MTPA_findSurfaceCell() function
+
+
+//*****************************************************************************
+//! \brief     Compute the current reference of MTPA from the MTPA surface,
+//!            same as MTPA_computeCurrentReference() without sqrt inside of
+//!            the grid. Beyond IsMax_A the surface is extrapolated linearly
+//!            and beyond the kconst range it is held at the edge, the
+//!            error is then larger than errorMaxIdq_A and flagSurfaceLimit
+//!            is set, see MTPA_getFlagSurfaceLimit()
+//! \param[in] handle      The maximum torque per ampere (MTPA) handle
+//! \param[in] surfHandle  The MTPA surface handle
+//! \param[in] Is_ref_A    The stator current reference value, A
+//! \return    None
+//*****************************************************************************
+static inline void
+MTPA_computeCurrentReferenceWithSurface(MTPA_Handle handle,
+                                        MTPA_SurfaceHandle surfHandle,
+                                        const float32_t Is_ref_A)
+{
+    MTPA_Obj *obj = (MTPA_Obj *)handle;
+    MTPA_Surface *surf = (MTPA_Surface *)surfHandle;
+
+    obj->Is_ref_A = MATH_abs(Is_ref_A);
+
+    if((MTPA_getFlagEnable(handle) == true) &&
+       (obj->kconst != 0.0f) && (obj->Is_ref_A != 0.0f))
+    {
+        uint16_t indexIs, indexK;
+        float32_t fracIs, fracK;
+
+        obj->flagSurfaceLimit =
+                MTPA_findSurfaceCell(surfHandle, obj->Is_ref_A, obj->kconst,
+                                     &indexIs, &indexK, &fracIs, &fracK);
+
+        obj->Idq_ref_A.value[0] =
+                MTPA_interpSurface(surf->Id_A, indexIs, indexK, fracIs, fracK);
+
+        obj->Idq_ref_A.value[1] =
+                MTPA_interpSurface(surf->Iq_A, indexIs, indexK, fracIs, fracK);
+
+        if(Is_ref_A < 0.0f)
+        {
+            obj->Idq_ref_A.value[1] = -obj->Idq_ref_A.value[1];
+        }
+    }
+    else
+    {
+        obj->flagSurfaceLimit = false;
+
+        obj->Idq_ref_A.value[0] = 0.0f;
+        obj->Idq_ref_A.value[1] = Is_ref_A;
+    }
+
+    return;
+} // end of MTPA_computeCurrentReferenceWithSurface() function
+
+
+//*****************************************************************************
+//! \brief     Compute the current angle of MTPA from the MTPA surface,
+//!            same as MTPA_computeCurrentAngle() without sqrt/acos inside of
+//!            the grid, outside of it see
+//!            MTPA_computeCurrentReferenceWithSurface()
+//! \param[in] handle      The maximum torque per ampere (MTPA) handle
+//! \param[in] surfHandle  The MTPA surface handle
+//! \param[in] Is_ref_A    The stator current reference value, A
+//! \return    The stator current phase angle value, rad
+//*****************************************************************************
+static inline float32_t
+MTPA_computeCurrentAngleWithSurface(MTPA_Handle handle,
+                                    MTPA_SurfaceHandle surfHandle,
+                                    const float32_t Is_ref_A)
+{
+    MTPA_Obj *obj = (MTPA_Obj *)handle;
+    MTPA_Surface *surf = (MTPA_Surface *)surfHandle;
+
+    obj->Is_ref_A = MATH_abs(Is_ref_A);
+
+    if((MTPA_getFlagEnable(handle) == true) &&
+       (obj->kconst != 0.0f) && (obj->Is_ref_A != 0.0f))
+    {
+        uint16_t indexIs, indexK;
+        float32_t fracIs, fracK;
+
+        obj->flagSurfaceLimit =
+                MTPA_findSurfaceCell(surfHandle, obj->Is_ref_A, obj->kconst,
+                                     &indexIs, &indexK, &fracIs, &fracK);
+
+        obj->angleCurrent_rad = MTPA_interpSurface(surf->angle_rad,
+                                                   indexIs, indexK,
+                                                   fracIs, fracK);
+    }
+    else
+    {
+        obj->flagSurfaceLimit = false;
+
+        obj->angleCurrent_rad = MATH_PI_OVER_TWO;
+    }
+
+    return(obj->angleCurrent_rad);
+} // end of MTPA_computeCurrentAngleWithSurface() function
+
+
 //*****************************************************************************
 //! \brief     Update the motor inductances
 //! \param[in] handle  The maximum torque per ampere (MTPA) handle
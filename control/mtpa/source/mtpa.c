@@ -149,6 +149,139 @@ void MTPA_computeParameters(MTPA_Handle handle,
     return;
 } // end of MTPA_computeParameters() function
 
+
+// ****************************************************************************
+//
+// MTPA_computeAnalytic, the exact MTPA solution for one operating point
+//
+// ****************************************************************************
+static void MTPA_computeAnalytic(const float32_t Is_A, const float32_t kconst_A,
+                                 float32_t *pId_A, float32_t *pIq_A,
+                                 float32_t *pAngle_rad)
+{
+    if((kconst_A != 0.0f) && (Is_A != 0.0f))
+    {
+        float32_t gconst = kconst_A / Is_A;
+        float32_t Id_A = kconst_A -
+                         sqrtf((kconst_A * kconst_A) + (0.5f * Is_A * Is_A));
+
+        *pId_A = Id_A;
+        *pIq_A = sqrtf(MATH_max((Is_A * Is_A) - (Id_A * Id_A), 0.0f));
+        *pAngle_rad = acosf(gconst - sqrtf(gconst * gconst + 0.5f));
+    }
+    else
+    {
+        *pId_A = 0.0f;
+        *pIq_A = Is_A;
+        *pAngle_rad = MATH_PI_OVER_TWO;
+    }
+
+    return;
+} // end of MTPA_computeAnalytic() function
+
+
+// ****************************************************************************
+//
+// MTPA_buildSurface
+//
+// ****************************************************************************
+void MTPA_buildSurface(MTPA_SurfaceHandle surfHandle,
+                       const float32_t IsMax_A,
+                       const float32_t kconstMin_A,
+                       const float32_t kconstMax_A)
+{
+    MTPA_Surface *surf = (MTPA_Surface *)surfHandle;
+
+    float32_t IsStep_A = IsMax_A / (float32_t)(MTPA_SURF_IS_NUM - 1);
+    float32_t kconstStep_A = (kconstMax_A - kconstMin_A) /
+                             (float32_t)(MTPA_SURF_K_NUM - 1);
+    uint16_t indexIs, indexK;
+
+    surf->IsMax_A = IsMax_A;
+    surf->kconstMin_A = kconstMin_A;
+    surf->kconstMax_A = kconstMax_A;
+
+    surf->IsStepInv_1oA = (IsStep_A > 0.0f) ? (1.0f / IsStep_A) : 0.0f;
+    surf->kconstStepInv_1oA =
+            (kconstStep_A != 0.0f) ? (1.0f / kconstStep_A) : 0.0f;
+
+    for(indexK = 0; indexK < MTPA_SURF_K_NUM; indexK++)
+    {
+        float32_t kconst_A = kconstMin_A + kconstStep_A * (float32_t)indexK;
+
+        for(indexIs = 0; indexIs < MTPA_SURF_IS_NUM; indexIs++)
+        {
+            MTPA_computeAnalytic(IsStep_A * (float32_t)indexIs, kconst_A,
+                                 &surf->Id_A[indexK][indexIs],
+                                 &surf->Iq_A[indexK][indexIs],
+                                 &surf->angle_rad[indexK][indexIs]);
+        }
+    }
+
+    surf->errorMaxIdq_A = 0.0f;
+    surf->errorMaxAngle_rad = 0.0f;
+
+    return;
+} // end of MTPA_buildSurface() function
+
+
+// ****************************************************************************
+//
+// MTPA_computeSurfaceError
+//
+// ****************************************************************************
+float32_t MTPA_computeSurfaceError(MTPA_SurfaceHandle surfHandle)
+{
+    MTPA_Surface *surf = (MTPA_Surface *)surfHandle;
+
+    // evaluate on a grid twice as dense as the surface, which includes the
+    // cell centers and the edge midpoints where the error is the largest
+    float32_t IsStep_A = 0.5f * surf->IsMax_A /
+                         (float32_t)(MTPA_SURF_IS_NUM - 1);
+    float32_t kconstStep_A = 0.5f * (surf->kconstMax_A - surf->kconstMin_A) /
+                             (float32_t)(MTPA_SURF_K_NUM - 1);
+    float32_t errorIdq_A = 0.0f;
+    float32_t errorAngle_rad = 0.0f;
+    uint16_t indexIs, indexK;
+
+    for(indexK = 0; indexK < (2 * MTPA_SURF_K_NUM - 1); indexK++)
+    {
+        float32_t kconst_A = surf->kconstMin_A +
+                             kconstStep_A * (float32_t)indexK;
+
+        // start from the first non-zero current, Is = 0 is handled outside
+        // of the surface by the runtime functions
+        for(indexIs = 1; indexIs < (2 * MTPA_SURF_IS_NUM - 1); indexIs++)
+        {
+            float32_t Is_A = IsStep_A * (float32_t)indexIs;
+            float32_t Id_A, Iq_A, angle_rad, fracIs, fracK;
+            uint16_t cellIs, cellK;
+
+            MTPA_computeAnalytic(Is_A, kconst_A, &Id_A, &Iq_A, &angle_rad);
+
+            MTPA_findSurfaceCell(surfHandle, Is_A, kconst_A,
+                                 &cellIs, &cellK, &fracIs, &fracK);
+
+            errorIdq_A = MATH_max(errorIdq_A, MATH_abs(Id_A -
+                    MTPA_interpSurface(surf->Id_A, cellIs, cellK,
+                                       fracIs, fracK)));
+
+            errorIdq_A = MATH_max(errorIdq_A, MATH_abs(Iq_A -
+                    MTPA_interpSurface(surf->Iq_A, cellIs, cellK,
+                                       fracIs, fracK)));
+
+            errorAngle_rad = MATH_max(errorAngle_rad, MATH_abs(angle_rad -
+                    MTPA_interpSurface(surf->angle_rad, cellIs, cellK,
+                                       fracIs, fracK)));
+        }
+    }
+
+    surf->errorMaxIdq_A = errorIdq_A;
+    surf->errorMaxAngle_rad = errorAngle_rad;
+
+    return(errorIdq_A);
+} // end of MTPA_computeSurfaceError() function
+
 //
 // end of file
 //
@@ -63,6 +63,21 @@ extern "C" {
 //!
 #define VIB_COMP_BUF_SIZE       (360)       // 360/3=120, every 3 degree
 
+//! \brief  Defines the maximum number of mechanical harmonics in the harmonic
+//!         vibration compensation
+//!
+#define VIB_COMP_HARM_NUM_MAX   (6)
+
+//! \brief  Defines the number of speed bands of the Q15 vibration compensation,
+//!         each band holds its own Q15 table of VIB_COMP_BUF_SIZE + 1 entries.
+//!         Two bands take the memory of the float table plus 16 words on C28x
+//!         for the band scales, limits and state, one band halves the memory
+//!         when the speed does not change enough to need band switching
+//!
+#ifndef VIB_COMP_Q15_BAND_NUM
+#define VIB_COMP_Q15_BAND_NUM   (2)
+#endif  // VIB_COMP_Q15_BAND_NUM
+
 // **************************************************************************
 // the typedefs
 
@@ -95,6 +110,84 @@ typedef struct _VIB_COMP_Obj_
 //!
 typedef struct _VIB_COMP_Obj_ *VIB_COMP_Handle;
 
+//! \brief Defines the harmonic Vibration Compensation object
+//!
+//! Instead of the feed forward table, the feed forward is represented by the
+//! sine/cosine coefficients of a few selected mechanical harmonics, which are
+//! learned with an adaptive feed forward (LMS) update on every sample
+//!
+typedef struct _VIB_COMP_HARM_Obj_
+{
+  float32_t coefCos[VIB_COMP_HARM_NUM_MAX];     //!< The learned cosine coefficients
+  float32_t coefSin[VIB_COMP_HARM_NUM_MAX];     //!< The learned sine coefficients
+  float32_t advCos[VIB_COMP_HARM_NUM_MAX];      //!< The cosine of the phase advance of each harmonic
+  float32_t advSin[VIB_COMP_HARM_NUM_MAX];      //!< The sine of the phase advance of each harmonic
+  float32_t orderF[VIB_COMP_HARM_NUM_MAX];      //!< The enabled harmonic orders as float, compact list
+  uint16_t  order[VIB_COMP_HARM_NUM_MAX];       //!< The mechanical harmonic orders, in ascending order
+  uint16_t  numHarmonics;                       //!< The number of harmonics in use
+
+  float32_t mu;                     //!< The learning gain of the coefficients
+  float32_t gain;                   //!< The gain of the feed forward output
+
+  float32_t anglePairsMax;
+  float32_t angleMechInvSf;
+
+  float32_t angleElecPrev_rad;
+  float32_t angleMechPoles_rad;
+  float32_t angleMech_rad;
+  float32_t Iq_outFF_A;
+
+  float32_t Iq_comp_A;
+
+  int16_t   indexDelta;             //!< The phase advance value in units of the VIB_COMP table index
+
+  bool      flagEnableFF;           //!< a flag to enable the usage of feed forward values
+} VIB_COMP_HARM_Obj;
+
+//! \brief Defines the VIB_COMP_HARM handle
+//!
+typedef struct _VIB_COMP_HARM_Obj_ *VIB_COMP_HARM_Handle;
+
+//! \brief Defines the Q15 Vibration Compensation object
+//!
+//! The feed forward tables are stored in Q15 with a scale per table, and one
+//! table is kept per speed band so that a speed change does not relearn the
+//! table of the previous speed
+//!
+typedef struct _VIB_COMP_Q15_Obj_
+{
+  int16_t   FF_table[VIB_COMP_Q15_BAND_NUM][VIB_COMP_BUF_SIZE + 1]; //!< The Q15 tables to store feed forward values
+  float32_t scale_A[VIB_COMP_Q15_BAND_NUM];             //!< The scale of each table, A per LSB
+  float32_t scaleInv[VIB_COMP_Q15_BAND_NUM];            //!< The inverse of the scale of each table, LSB per A
+  float32_t speedBand_Hz[VIB_COMP_Q15_BAND_NUM];        //!< The upper speed limit of each band
+  float32_t speedHyst_Hz;           //!< The speed hysteresis of the band switching
+  float32_t residualQ15;            //!< The rounding error carried into the next table write, LSB
+
+  float32_t alpha;                  //!< The filter coefficient to calculate the feed forward table
+  float32_t beta;                   //!< The filter coefficient to calculate the feed forward table
+
+  float32_t anglePairsMax;
+  float32_t angleMechInvSf;
+  float32_t indexSf;
+
+  float32_t angleElecPrev_rad;
+  float32_t angleMechPoles_rad;
+  float32_t angleMech_rad;
+  float32_t Iq_outFF_A;
+
+  float32_t Iq_comp_A;
+
+  int16_t   index;                  //!< The table index
+  int16_t   indexDelta;             //!< The phase advance value to be applied when using the table
+  uint16_t  band;                   //!< The speed band in use
+
+  bool      flagEnableFF;           //!< a flag to enable the usage of feed forward values
+} VIB_COMP_Q15_Obj;
+
+//! \brief Defines the VIB_COMP_Q15 handle
+//!
+typedef struct _VIB_COMP_Q15_Obj_ *VIB_COMP_Q15_Handle;
+
 
 // the function prototypes
 
@@ -144,51 +237,27 @@ extern VIB_COMP_Handle VIB_COMP_init(void *pMemory, const size_t numBytes);
 //! \param[in] handle  The vibration compensation handle
 extern void VIB_COMP_reset(VIB_COMP_Handle handle);
 
-//! \brief     Runs the vibration compensation algorithm
-//! \param[in] handle         The vibration compensation handle
-//! \param[in] angle_mech_pu  The mechanical angle in per units from _IQ(0.0) to _IQ(1.0)
-//! \param[in] Iq_in_pu       The measured Iq in per units
-//! \return    The value to be used as a feed forward term in the speed controller
-
-static inline float32_t VIB_COMP_run(VIB_COMP_Handle handle,
-                         const float32_t angleElec_rad, const float32_t Iq_in_A)
+//! \brief     Calculates the mechanical angle from the electrical angle for the
+//!            run functions that take the electrical angle. When several
+//!            modules need the mechanical angle, run one ANGLE_MECH tracker
+//!            per axis and use the runIndex()/runAngle() functions instead
+//! \param[in] angleElec_rad        The electrical angle, -pi ~ pi
+//! \param[in] pAngleElecPrev_rad   The pointer to the previous electrical angle
+//! \param[in] pAngleMechPoles_rad  The pointer to the pole-pairs scaled
+//!                                 mechanical angle
+//! \param[in] anglePairsMax        The number of pole pairs times 2*pi
+//! \param[in] angleMechInvSf       The inverse of the number of pole pairs
+//! \return    The mechanical angle, 0 ~ 2*pi
+static inline float32_t VIB_COMP_computeAngleMech(const float32_t angleElec_rad,
+                                                  float32_t *pAngleElecPrev_rad,
+                                                  float32_t *pAngleMechPoles_rad,
+                                                  const float32_t anglePairsMax,
+                                                  const float32_t angleMechInvSf)
 {
-    VIB_COMP_Obj *obj = (VIB_COMP_Obj *)handle;
-    //! \brief      Calculates mechanical angle from electrical angle
     float32_t angleElecAbs_rad;
     float32_t angleElecDelta_rad;
     float32_t angleMechTemp_rad;        // temporary value for intermediate calculations
 
-    int16_t tmp_adv_index;
-
-    obj->index = (int16_t)(obj->angleMech_rad * obj->indexSf);
-
-    obj->index = (obj->index >= (int16_t)VIB_COMP_BUF_SIZE) ?
-            ((int16_t)VIB_COMP_BUF_SIZE - 1) : obj->index;
-
-    obj->index = (obj->index < 0) ? 0 : obj->index;
-
-    tmp_adv_index = obj->index + obj->indexDelta;
-
-    tmp_adv_index = (tmp_adv_index >= (int16_t)VIB_COMP_BUF_SIZE) ?
-            (tmp_adv_index - (int16_t)VIB_COMP_BUF_SIZE) : tmp_adv_index;
-
-    tmp_adv_index = (tmp_adv_index < 0) ? 0 : tmp_adv_index;
-
-    obj->FF_table[obj->index] = obj->alpha * obj->FF_table[obj->index] +
-            obj->beta * Iq_in_A;
-
-    obj->Iq_comp_A = obj->FF_table[tmp_adv_index];  // only for debugging
-
-    if(obj->flagEnableFF == true)
-    {
-        obj->Iq_outFF_A = obj->FF_table[tmp_adv_index];
-    }
-    else
-    {
-        obj->Iq_outFF_A = 0.0f;
-    }
-
     // calculates angle delta, (-pi, pi) -> (0, pi)
     if(angleElec_rad < 0.0f)
     {
@@ -199,13 +268,13 @@ static inline float32_t VIB_COMP_run(VIB_COMP_Handle handle,
         angleElecAbs_rad = angleElec_rad;
     }
 
-    angleElecDelta_rad = angleElecAbs_rad - obj->angleElecPrev_rad;
+    angleElecDelta_rad = angleElecAbs_rad - *pAngleElecPrev_rad;
 
     // store the angle so next time this function is called we have the angle from the previous sample
-    obj->angleElecPrev_rad = angleElecAbs_rad;
+    *pAngleElecPrev_rad = angleElecAbs_rad;
 
     // calculate new mechanical angle
-    angleMechTemp_rad = obj->angleMechPoles_rad + angleElecDelta_rad;
+    angleMechTemp_rad = *pAngleMechPoles_rad + angleElecDelta_rad;
 
     // take care of delta calculations when electrical angle wraps around
     // from -2*PI to 0.0 or from 0.0 to 2*PI
@@ -221,31 +290,98 @@ static inline float32_t VIB_COMP_run(VIB_COMP_Handle handle,
     // take care of wrap around of the mechanical angle,
     // so that angle_mech_poles stays within -USER_MOTOR_NUM_POLE_PAIRS*2*PI
     // to USER_MOTOR_NUM_POLE_PAIRS*2*PI
-    if(angleMechTemp_rad >= obj->anglePairsMax)
+    if(angleMechTemp_rad >= anglePairsMax)
     {
-        angleMechTemp_rad = angleMechTemp_rad - obj->anglePairsMax;
+        angleMechTemp_rad = angleMechTemp_rad - anglePairsMax;
     }
-    else if(angleMechTemp_rad <= -obj->anglePairsMax)
+    else if(angleMechTemp_rad <= -anglePairsMax)
     {
-        angleMechTemp_rad = angleMechTemp_rad + obj->anglePairsMax;
+        angleMechTemp_rad = angleMechTemp_rad + anglePairsMax;
     }
 
     // store value in angle_mech_poles
-    obj->angleMechPoles_rad = angleMechTemp_rad;
+    *pAngleMechPoles_rad = angleMechTemp_rad;
 
     // scale the mechanical angle so that final output is from -2*PI to 2*PI
-    angleMechTemp_rad =  angleMechTemp_rad * obj->angleMechInvSf;
+    angleMechTemp_rad =  angleMechTemp_rad * angleMechInvSf;
 
     // make the final mechanical angle a positive only values from 0.0 to 2*PI
     if(angleMechTemp_rad < 0.0f)
     {
-        obj->angleMech_rad = angleMechTemp_rad + MATH_TWO_PI;
+        angleMechTemp_rad = angleMechTemp_rad + MATH_TWO_PI;
+    }
+
+    return(angleMechTemp_rad);
+} // end of VIB_COMP_computeAngleMech() function
+
+//! \brief     Runs the vibration compensation algorithm on a table index, the
+//!            index is taken from a shared mechanical angle tracker
+//!            (ANGLE_MECH) so the angle is not computed again here
+//! \param[in] handle         The vibration compensation handle
+//! \param[in] index          The table index of the mechanical angle
+//! \param[in] Iq_in_A        The measured Iq, A
+//! \return    The value to be used as a feed forward term in the speed controller
+static inline float32_t VIB_COMP_runIndex(VIB_COMP_Handle handle,
+                         const int16_t index, const float32_t Iq_in_A)
+{
+    VIB_COMP_Obj *obj = (VIB_COMP_Obj *)handle;
+
+    int16_t tmp_adv_index;
+
+    obj->index = index;
+
+    tmp_adv_index = obj->index + obj->indexDelta;
+
+    tmp_adv_index = (tmp_adv_index >= (int16_t)VIB_COMP_BUF_SIZE) ?
+            (tmp_adv_index - (int16_t)VIB_COMP_BUF_SIZE) : tmp_adv_index;
+
+    tmp_adv_index = (tmp_adv_index < 0) ? 0 : tmp_adv_index;
+
+    obj->FF_table[obj->index] = obj->alpha * obj->FF_table[obj->index] +
+            obj->beta * Iq_in_A;
+
+    obj->Iq_comp_A = obj->FF_table[tmp_adv_index];  // only for debugging
+
+    if(obj->flagEnableFF == true)
+    {
+        obj->Iq_outFF_A = obj->FF_table[tmp_adv_index];
     }
     else
     {
-        obj->angleMech_rad = angleMechTemp_rad;
+        obj->Iq_outFF_A = 0.0f;
     }
 
+    return(obj->Iq_outFF_A);
+} // end of VIB_COMP_runIndex() function
+
+//! \brief     Runs the vibration compensation algorithm
+//! \param[in] handle         The vibration compensation handle
+//! \param[in] angle_mech_pu  The mechanical angle in per units from _IQ(0.0) to _IQ(1.0)
+//! \param[in] Iq_in_pu       The measured Iq in per units
+//! \return    The value to be used as a feed forward term in the speed controller
+
+static inline float32_t VIB_COMP_run(VIB_COMP_Handle handle,
+                         const float32_t angleElec_rad, const float32_t Iq_in_A)
+{
+    VIB_COMP_Obj *obj = (VIB_COMP_Obj *)handle;
+    int16_t index;
+
+    index = (int16_t)(obj->angleMech_rad * obj->indexSf);
+
+    index = (index >= (int16_t)VIB_COMP_BUF_SIZE) ?
+            ((int16_t)VIB_COMP_BUF_SIZE - 1) : index;
+
+    index = (index < 0) ? 0 : index;
+
+    VIB_COMP_runIndex(handle, index, Iq_in_A);
+
+    // calculates mechanical angle from electrical angle
+    obj->angleMech_rad = VIB_COMP_computeAngleMech(angleElec_rad,
+                                                   &obj->angleElecPrev_rad,
+                                                   &obj->angleMechPoles_rad,
+                                                   obj->anglePairsMax,
+                                                   obj->angleMechInvSf);
+
     return(obj->Iq_outFF_A);
 } // end of VIB_COMP_run() function
 
@@ -312,72 +448,322 @@ static inline void VIB_COMP_setIndex(VIB_COMP_Handle handle,const int16_t index)
     return;
 } // end of VIB_COMP_setIndex() function
 
-inline float32_t VIB_COMP_calcMechangle(VIB_COMP_Handle handle,
+static inline float32_t VIB_COMP_calcMechangle(VIB_COMP_Handle handle,
                          const float32_t angleElec_rad)
 {
     VIB_COMP_Obj *obj = (VIB_COMP_Obj *)handle;
-    //! \brief      Calculates mechanical angle from electrical angle
-    float32_t angleElecAbs_rad;
-    float32_t angleElecDelta_rad;
-    float32_t angleMechTemp_rad;        // temporary value for intermediate calculations
 
-    // calculates angle delta
-    if(angleElec_rad < 0.0f)
-    {
-        angleElecAbs_rad = angleElec_rad + MATH_TWO_PI;
-    }
-    else
+    // calculates mechanical angle from electrical angle
+    obj->angleMech_rad = VIB_COMP_computeAngleMech(angleElec_rad,
+                                                   &obj->angleElecPrev_rad,
+                                                   &obj->angleMechPoles_rad,
+                                                   obj->anglePairsMax,
+                                                   obj->angleMechInvSf);
+
+    return(obj->angleMech_rad);
+} // end of VIB_COMP_Mechangle_run() function
+
+
+//! \brief     Runs the harmonic vibration compensation algorithm on a
+//!            mechanical angle, the angle is taken from a shared mechanical
+//!            angle tracker (ANGLE_MECH) so it is not computed again here
+//! \param[in] handle         The harmonic vibration compensation handle
+//! \param[in] angleMech_rad  The mechanical angle, 0 ~ 2*pi rad
+//! \param[in] Iq_in_A        The measured Iq, A
+//! \return    The value to be used as a feed forward term in the speed controller
+static inline float32_t VIB_COMP_HARM_runAngle(VIB_COMP_HARM_Handle handle,
+                         const float32_t angleMech_rad, const float32_t Iq_in_A)
+{
+    VIB_COMP_HARM_Obj *obj = (VIB_COMP_HARM_Obj *)handle;
+    float32_t harmCos[VIB_COMP_HARM_NUM_MAX];
+    float32_t harmSin[VIB_COMP_HARM_NUM_MAX];
+    float32_t anglePu = angleMech_rad * MATH_ONE_OVER_TWO_PI;
+    float32_t angleOrder_pu;
+    float32_t Iq_est_A = 0.0f;
+    float32_t Iq_ff_A = 0.0f;
+    float32_t error;
+    uint16_t cnt;
+
+    // evaluates only the enabled harmonics, the cost scales with the number
+    // of harmonics in use and not with the highest order
+    for(cnt = 0; cnt < obj->numHarmonics; cnt++)
     {
-        angleElecAbs_rad = angleElec_rad;
+        angleOrder_pu = anglePu * obj->orderF[cnt];
+        angleOrder_pu -= (float32_t)((int32_t)angleOrder_pu);
+
+        harmCos[cnt] = __cospuf32(angleOrder_pu);
+        harmSin[cnt] = __sinpuf32(angleOrder_pu);
+
+        Iq_est_A += obj->coefCos[cnt] * harmCos[cnt] +
+                    obj->coefSin[cnt] * harmSin[cnt];
     }
 
-    angleElecDelta_rad = angleElecAbs_rad - obj->angleElecPrev_rad;
+    error = obj->mu * (Iq_in_A - Iq_est_A);
 
-    // store the angle so next time this function is called we have the angle from the previous sample
-    obj->angleElecPrev_rad = angleElecAbs_rad;
+    for(cnt = 0; cnt < obj->numHarmonics; cnt++)
+    {
+        obj->coefCos[cnt] += error * harmCos[cnt];
+        obj->coefSin[cnt] += error * harmSin[cnt];
+
+        // evaluates the harmonic at the phase advanced angle
+        Iq_ff_A += obj->coefCos[cnt] * (harmCos[cnt] * obj->advCos[cnt] -
+                                        harmSin[cnt] * obj->advSin[cnt]) +
+                   obj->coefSin[cnt] * (harmSin[cnt] * obj->advCos[cnt] +
+                                        harmCos[cnt] * obj->advSin[cnt]);
+    }
 
-    // calculate new mechanical angle
-    angleMechTemp_rad = obj->angleMechPoles_rad + angleElecDelta_rad;
+    obj->Iq_comp_A = obj->gain * Iq_ff_A;  // only for debugging
 
-    // take care of delta calculations when electrical angle wraps around from _IQ(1.0) to _IQ(0.0) or from _IQ(0.0) to _IQ(1.0)
-    if(angleElecDelta_rad < -MATH_PI)
+    if(obj->flagEnableFF == true)
     {
-        angleMechTemp_rad = angleMechTemp_rad + MATH_TWO_PI;
+        obj->Iq_outFF_A = obj->Iq_comp_A;
     }
-    else if(angleElecDelta_rad > MATH_PI)
+    else
     {
-        angleMechTemp_rad = angleMechTemp_rad - MATH_TWO_PI;
+        obj->Iq_outFF_A = 0.0f;
     }
 
-    // take care of wrap around of the mechanical angle, so that angle_mech_poles stays within _IQ(-USER_MOTOR_NUM_POLE_PAIRS) to _IQ(USER_MOTOR_NUM_POLE_PAIRS)
-    if(angleMechTemp_rad >= obj->anglePairsMax)
+    return(obj->Iq_outFF_A);
+} // end of VIB_COMP_HARM_runAngle() function
+
+//! \brief     Runs the harmonic vibration compensation algorithm
+//! \param[in] handle         The harmonic vibration compensation handle
+//! \param[in] angleElec_rad  The electrical angle, rad
+//! \param[in] Iq_in_A        The measured Iq, A
+//! \return    The value to be used as a feed forward term in the speed controller
+static inline float32_t VIB_COMP_HARM_run(VIB_COMP_HARM_Handle handle,
+                         const float32_t angleElec_rad, const float32_t Iq_in_A)
+{
+    VIB_COMP_HARM_Obj *obj = (VIB_COMP_HARM_Obj *)handle;
+
+    VIB_COMP_HARM_runAngle(handle, obj->angleMech_rad, Iq_in_A);
+
+    // calculates mechanical angle from electrical angle
+    obj->angleMech_rad = VIB_COMP_computeAngleMech(angleElec_rad,
+                                                   &obj->angleElecPrev_rad,
+                                                   &obj->angleMechPoles_rad,
+                                                   obj->anglePairsMax,
+                                                   obj->angleMechInvSf);
+
+    return(obj->Iq_outFF_A);
+} // end of VIB_COMP_HARM_run() function
+
+//! \brief     Sets the flag of the harmonic vibration compensation output
+//! \param[in] handle         The harmonic vibration compensation handle
+static inline void VIB_COMP_HARM_setFlag_enableOutput(VIB_COMP_HARM_Handle handle,
+                                                      const bool state)
+{
+    VIB_COMP_HARM_Obj *obj = (VIB_COMP_HARM_Obj *)handle;
+
+    obj->flagEnableFF = state;
+
+    return;
+} // end of VIB_COMP_HARM_setFlag_enableOutput() function
+
+//! \brief     Initializes the harmonic vibration compensation module with no
+//!            harmonics in use, cleared coefficients and the output disabled
+//! \param[in] pMemory   A pointer to the harmonic vibration compensation object memory
+//! \param[in] numBytes  The number of bytes allocated for the object, bytes
+//! \return    The harmonic vibration compensation (VIB_COMP_HARM) object handle
+extern VIB_COMP_HARM_Handle VIB_COMP_HARM_init(void *pMemory, const size_t numBytes);
+
+//! \brief     Resets the learned coefficients of the harmonic vibration compensation
+//! \param[in] handle  The harmonic vibration compensation handle
+extern void VIB_COMP_HARM_reset(VIB_COMP_HARM_Handle handle);
+
+//! \brief     Sets the phase advance of the harmonic vibration compensation, with
+//!            the same meaning as the index delta of the VIB_COMP table
+//! \param[in] handle      The harmonic vibration compensation handle
+//! \param[in] indexDelta  The phase advance in units of 360/VIB_COMP_BUF_SIZE degree
+extern void VIB_COMP_HARM_setAdvIndexDelta(VIB_COMP_HARM_Handle handle,
+                                           const int16_t indexDelta);
+
+//! \brief     set up parameters for the harmonic vibration compensation algorithm
+//!            A learning gain mu around 2/(samples per mechanical revolution)
+//!            converges in a few revolutions. The learned coefficients are
+//!            kept for the orders that are unchanged and cleared for the rest
+//! \param[in] handle        The harmonic vibration compensation handle
+//! \param[in] mu            The learning gain of the coefficients
+//! \param[in] gain          The gain of the feed forward output
+//! \param[in] indexDelta    The phase advance in units of 360/VIB_COMP_BUF_SIZE degree
+//! \param[in] numPolePairs  The number of motor pole pairs
+//! \param[in] pOrder        The pointer to the mechanical harmonic orders
+//! \param[in] numHarmonics  The number of harmonic orders
+extern void VIB_COMP_HARM_setParams(VIB_COMP_HARM_Handle handle,
+                                    const float32_t mu, const float32_t gain,
+                                    const int16_t indexDelta,
+                                    const uint16_t numPolePairs,
+                                    const uint16_t *pOrder,
+                                    const uint16_t numHarmonics);
+
+//! \brief     Runs the Q15 vibration compensation algorithm on a table index, the
+//!            index is taken from a shared mechanical angle tracker
+//!            (ANGLE_MECH) so the angle is not computed again here
+//! \param[in] handle         The Q15 vibration compensation handle
+//! \param[in] index          The table index of the mechanical angle
+//! \param[in] Iq_in_A        The measured Iq, A
+//! \return    The value to be used as a feed forward term in the speed controller
+static inline float32_t VIB_COMP_Q15_runIndex(VIB_COMP_Q15_Handle handle,
+                         const int16_t index, const float32_t Iq_in_A)
+{
+    VIB_COMP_Q15_Obj *obj = (VIB_COMP_Q15_Obj *)handle;
+    int16_t *pTable = &obj->FF_table[obj->band][0];
+    float32_t scale_A = obj->scale_A[obj->band];
+    float32_t valueQ15;
+    float32_t valueRound;
+
+    int16_t tmp_adv_index;
+
+    obj->index = index;
+
+    tmp_adv_index = obj->index + obj->indexDelta;
+
+    tmp_adv_index = (tmp_adv_index >= (int16_t)VIB_COMP_BUF_SIZE) ?
+            (tmp_adv_index - (int16_t)VIB_COMP_BUF_SIZE) : tmp_adv_index;
+
+    tmp_adv_index = (tmp_adv_index < 0) ? 0 : tmp_adv_index;
+
+    // filter in float and round back to Q15 with saturation, the rounding
+    // error is fed into the next write so that an update smaller than half
+    // an LSB is not lost, otherwise the table stalls within a deadband of
+    // about 0.5/(1 - alpha) LSB around the learned value
+    valueQ15 = obj->alpha * (float32_t)pTable[obj->index] +
+               obj->beta * obj->scaleInv[obj->band] * Iq_in_A +
+               obj->residualQ15;
+
+    valueRound = MATH_sat(valueQ15 + ((valueQ15 < 0.0f) ? -0.5f : 0.5f),
+                          32767.0f, -32768.0f);
+
+    pTable[obj->index] = (int16_t)valueRound;
+
+    obj->residualQ15 = MATH_sat(valueQ15 - (float32_t)pTable[obj->index],
+                                0.5f, -0.5f);
+
+    obj->Iq_comp_A = scale_A * (float32_t)pTable[tmp_adv_index];  // only for debugging
+
+    if(obj->flagEnableFF == true)
     {
-        angleMechTemp_rad = angleMechTemp_rad - obj->anglePairsMax;
+        obj->Iq_outFF_A = obj->Iq_comp_A;
     }
-    else if(angleMechTemp_rad <= -obj->anglePairsMax)
+    else
     {
-        angleMechTemp_rad = angleMechTemp_rad + obj->anglePairsMax;
+        obj->Iq_outFF_A = 0.0f;
     }
 
-    // store value in angle_mech_poles
-    obj->angleMechPoles_rad = angleMechTemp_rad;
+    return(obj->Iq_outFF_A);
+} // end of VIB_COMP_Q15_runIndex() function
 
-    // scale the mechanical angle so that final output is from -1.0 to 1.0
-    angleMechTemp_rad =  angleMechTemp_rad * obj->angleMechInvSf;
+//! \brief     Runs the Q15 vibration compensation algorithm
+//! \param[in] handle         The Q15 vibration compensation handle
+//! \param[in] angleElec_rad  The electrical angle, rad
+//! \param[in] Iq_in_A        The measured Iq, A
+//! \return    The value to be used as a feed forward term in the speed controller
+static inline float32_t VIB_COMP_Q15_run(VIB_COMP_Q15_Handle handle,
+                         const float32_t angleElec_rad, const float32_t Iq_in_A)
+{
+    VIB_COMP_Q15_Obj *obj = (VIB_COMP_Q15_Obj *)handle;
+    int16_t index;
 
-    // make the final mechanical angle a positive only values from 0.0 to 1.0
-    if(angleMechTemp_rad < 0.0f)
+    index = (int16_t)(obj->angleMech_rad * obj->indexSf);
+
+    index = (index >= (int16_t)VIB_COMP_BUF_SIZE) ?
+            ((int16_t)VIB_COMP_BUF_SIZE - 1) : index;
+
+    index = (index < 0) ? 0 : index;
+
+    VIB_COMP_Q15_runIndex(handle, index, Iq_in_A);
+
+    // calculates mechanical angle from electrical angle
+    obj->angleMech_rad = VIB_COMP_computeAngleMech(angleElec_rad,
+                                                   &obj->angleElecPrev_rad,
+                                                   &obj->angleMechPoles_rad,
+                                                   obj->anglePairsMax,
+                                                   obj->angleMechInvSf);
+
+    return(obj->Iq_outFF_A);
+} // end of VIB_COMP_Q15_run() function
+
+//! \brief     Gets the speed band in use of the Q15 vibration compensation
+//! \param[in] handle         The Q15 vibration compensation handle
+static inline uint16_t VIB_COMP_Q15_getBand(VIB_COMP_Q15_Handle handle)
+{
+    VIB_COMP_Q15_Obj *obj = (VIB_COMP_Q15_Obj *)handle;
+
+    return(obj->band);
+} // end of VIB_COMP_Q15_getBand() function
+
+//! \brief     Sets the flag of the Q15 vibration compensation output
+//! \param[in] handle         The Q15 vibration compensation handle
+static inline void VIB_COMP_Q15_setFlag_enableOutput(VIB_COMP_Q15_Handle handle,
+                                                     const bool state)
+{
+    VIB_COMP_Q15_Obj *obj = (VIB_COMP_Q15_Obj *)handle;
+
+    obj->flagEnableFF = state;
+
+    return;
+} // end of VIB_COMP_Q15_setFlag_enableOutput() function
+
+//! \brief     Selects the table of the speed band, the band only changes when
+//!            the speed leaves the band by more than the hysteresis, it is
+//!            called in the speed loop or the background loop
+//! \param[in] handle    The Q15 vibration compensation handle
+//! \param[in] speed_Hz  The motor speed, Hz
+static inline void VIB_COMP_Q15_updateBand(VIB_COMP_Q15_Handle handle,
+                                           const float32_t speed_Hz)
+{
+    VIB_COMP_Q15_Obj *obj = (VIB_COMP_Q15_Obj *)handle;
+    float32_t speedAbs_Hz = MATH_abs(speed_Hz);
+
+    if(((obj->band + 1U) < VIB_COMP_Q15_BAND_NUM) &&
+       (speedAbs_Hz > (obj->speedBand_Hz[obj->band] + obj->speedHyst_Hz)))
     {
-        obj->angleMech_rad = angleMechTemp_rad + MATH_TWO_PI;
+        obj->band++;
     }
-    else
+    else if((obj->band > 0) &&
+       (speedAbs_Hz < (obj->speedBand_Hz[obj->band - 1] - obj->speedHyst_Hz)))
     {
-        obj->angleMech_rad = angleMechTemp_rad;
+        obj->band--;
     }
 
-    return(obj->angleMech_rad);
-} // end of VIB_COMP_Mechangle_run() function
-
+    return;
+} // end of VIB_COMP_Q15_updateBand() function
+
+//! \brief     Initializes the Q15 vibration compensation module
+//! \param[in] pMemory   A pointer to the Q15 vibration compensation object memory
+//! \param[in] numBytes  The number of bytes allocated for the object, bytes
+//! \return    The Q15 vibration compensation (VIB_COMP_Q15) object handle
+extern VIB_COMP_Q15_Handle VIB_COMP_Q15_init(void *pMemory, const size_t numBytes);
+
+//! \brief     Resets the tables of the Q15 vibration compensation
+//! \param[in] handle  The Q15 vibration compensation handle
+extern void VIB_COMP_Q15_reset(VIB_COMP_Q15_Handle handle);
+
+//! \brief     Sets the full scale of the table of one speed band, the learned
+//!            values of the table are rescaled to the new full scale
+//! \param[in] handle    The Q15 vibration compensation handle
+//! \param[in] band      The speed band
+//! \param[in] IqMax_A   The full scale of the table, A
+extern void VIB_COMP_Q15_setScale(VIB_COMP_Q15_Handle handle,
+                                  const uint16_t band, const float32_t IqMax_A);
+
+//! \brief     set up parameters for the Q15 vibration compensation algorithm
+//! \param[in] handle         The Q15 vibration compensation handle
+//! \param[in] alpha          The filter coefficient of the tables
+//! \param[in] gain           The gain of the tables
+//! \param[in] indexDelta     The phase advance value to be applied when using the table
+//! \param[in] numPolePairs   The number of motor pole pairs
+//! \param[in] IqMax_A        The full scale of all tables, A
+//! \param[in] pSpeedBand_Hz  The pointer to the upper speed limits of the first
+//!                           VIB_COMP_Q15_BAND_NUM - 1 bands, ascending, Hz
+//! \param[in] speedHyst_Hz   The speed hysteresis of the band switching, Hz
+extern void VIB_COMP_Q15_setParams(VIB_COMP_Q15_Handle handle,
+                                   const float32_t alpha, const float32_t gain,
+                                   const int16_t indexDelta,
+                                   const uint16_t numPolePairs,
+                                   const float32_t IqMax_A,
+                                   const float32_t *pSpeedBand_Hz,
+                                   const float32_t speedHyst_Hz);
 
 //! \brief     set up parameters for the automatic vibration compensation algorithm
 //! \param[in] handle         The vibration compensation handle
@@ -124,4 +124,258 @@ void VIB_COMPT_setParams(VIB_COMP_Handle handle, const uint16_t numPolePairs)
     return;
 } // end of VIB_COMPT_setParams() function
 
+VIB_COMP_HARM_Handle VIB_COMP_HARM_init(void *pMemory, const size_t numBytes)
+{
+    VIB_COMP_HARM_Handle vib_compHarmHandle;
+
+
+    if(numBytes < sizeof(VIB_COMP_HARM_Obj))
+    {
+        return((VIB_COMP_HARM_Handle)NULL);
+    }
+
+    // assign the handle
+    vib_compHarmHandle = (VIB_COMP_HARM_Handle)pMemory;
+
+    // no harmonic is in use, so VIB_COMP_HARM_setParams() clears the
+    // coefficients of every order it sets
+    ((VIB_COMP_HARM_Obj *)vib_compHarmHandle)->numHarmonics = 0;
+
+    VIB_COMP_HARM_reset(vib_compHarmHandle);
+
+    return(vib_compHarmHandle);
+} // end of VIB_COMP_HARM_init() function
+
+void VIB_COMP_HARM_reset(VIB_COMP_HARM_Handle handle)
+{
+    VIB_COMP_HARM_Obj *obj = (VIB_COMP_HARM_Obj *)handle;
+    int16_t cnt;
+
+    obj->flagEnableFF = false;
+
+    for(cnt = 0; cnt < (int16_t)VIB_COMP_HARM_NUM_MAX; cnt++)
+    {
+        obj->coefCos[cnt] = 0.0f;
+        obj->coefSin[cnt] = 0.0f;
+    }
+
+    return;
+} // end of VIB_COMP_HARM_reset() function
+
+void VIB_COMP_HARM_setAdvIndexDelta(VIB_COMP_HARM_Handle handle,
+                                    const int16_t indexDelta)
+{
+    VIB_COMP_HARM_Obj *obj = (VIB_COMP_HARM_Obj *)handle;
+    float32_t angleAdv_rad;
+    uint16_t cnt;
+
+    obj->indexDelta = indexDelta;
+
+    for(cnt = 0; cnt < obj->numHarmonics; cnt++)
+    {
+        angleAdv_rad = (float32_t)obj->order[cnt] * (float32_t)indexDelta *
+                       (MATH_TWO_PI / (float32_t)VIB_COMP_BUF_SIZE);
+
+        obj->advCos[cnt] = cosf(angleAdv_rad);
+        obj->advSin[cnt] = sinf(angleAdv_rad);
+    }
+
+    return;
+} // end of VIB_COMP_HARM_setAdvIndexDelta() function
+
+void VIB_COMP_HARM_setParams(VIB_COMP_HARM_Handle handle,
+                             const float32_t mu, const float32_t gain,
+                             const int16_t indexDelta,
+                             const uint16_t numPolePairs,
+                             const uint16_t *pOrder,
+                             const uint16_t numHarmonics)
+{
+    VIB_COMP_HARM_Obj *obj = (VIB_COMP_HARM_Obj *)handle;
+    uint16_t orderPrev[VIB_COMP_HARM_NUM_MAX];
+    uint16_t numHarmonicsPrev = obj->numHarmonics;
+    uint16_t cnt, pos;
+    uint16_t order;
+
+    obj->mu = mu;
+    obj->gain = gain;
+
+    obj->anglePairsMax = ((float32_t)numPolePairs) * MATH_TWO_PI;
+    obj->angleMechInvSf = 1.0f / ((float32_t)numPolePairs);
+
+    obj->angleElecPrev_rad = 0.0f;
+    obj->angleMechPoles_rad = 0.0f;
+    obj->angleMech_rad = 0.0f;
+
+    memcpy(orderPrev, obj->order, sizeof(orderPrev));
+
+    // keep the orders ascending and unique, zero orders are dropped
+    obj->numHarmonics = 0;
+
+    for(cnt = 0; cnt < numHarmonics; cnt++)
+    {
+        order = pOrder[cnt];
+
+        if(order == 0)
+        {
+            continue;
+        }
+
+        for(pos = 0; pos < obj->numHarmonics; pos++)
+        {
+            if(obj->order[pos] >= order)
+            {
+                break;
+            }
+        }
+
+        if((pos < obj->numHarmonics) && (obj->order[pos] == order))
+        {
+            continue;
+        }
+
+        if(obj->numHarmonics >= VIB_COMP_HARM_NUM_MAX)
+        {
+            if(pos >= VIB_COMP_HARM_NUM_MAX)
+            {
+                continue;
+            }
+
+            obj->numHarmonics--;
+        }
+
+        memmove(&obj->order[pos + 1], &obj->order[pos],
+                (obj->numHarmonics - pos) * sizeof(obj->order[0]));
+
+        obj->order[pos] = order;
+        obj->numHarmonics++;
+    }
+
+    // the learned coefficients only stay valid for an unchanged order
+    for(cnt = 0; cnt < obj->numHarmonics; cnt++)
+    {
+        if((cnt >= numHarmonicsPrev) || (obj->order[cnt] != orderPrev[cnt]))
+        {
+            obj->coefCos[cnt] = 0.0f;
+            obj->coefSin[cnt] = 0.0f;
+        }
+
+        obj->orderF[cnt] = (float32_t)obj->order[cnt];
+    }
+
+    VIB_COMP_HARM_setAdvIndexDelta(handle, indexDelta);
+
+    return;
+} // end of VIB_COMP_HARM_setParams() function
+
+VIB_COMP_Q15_Handle VIB_COMP_Q15_init(void *pMemory, const size_t numBytes)
+{
+    VIB_COMP_Q15_Handle vib_compQ15Handle;
+
+
+    if(numBytes < sizeof(VIB_COMP_Q15_Obj))
+    {
+        return((VIB_COMP_Q15_Handle)NULL);
+    }
+
+    // assign the handle
+    vib_compQ15Handle = (VIB_COMP_Q15_Handle)pMemory;
+
+    return(vib_compQ15Handle);
+} // end of VIB_COMP_Q15_init() function
+
+void VIB_COMP_Q15_reset(VIB_COMP_Q15_Handle handle)
+{
+    VIB_COMP_Q15_Obj *obj = (VIB_COMP_Q15_Obj *)handle;
+    int16_t band, cnt;
+
+    obj->flagEnableFF = false;
+
+    obj->index = 0;
+    obj->residualQ15 = 0.0f;
+
+    for(band = 0; band < (int16_t)VIB_COMP_Q15_BAND_NUM; band++)
+    {
+        for(cnt = 0; cnt < (int16_t)VIB_COMP_BUF_SIZE; cnt++)
+        {
+            obj->FF_table[band][cnt] = 0;
+        }
+    }
+
+    return;
+} // end of VIB_COMP_Q15_reset() function
+
+void VIB_COMP_Q15_setScale(VIB_COMP_Q15_Handle handle,
+                           const uint16_t band, const float32_t IqMax_A)
+{
+    VIB_COMP_Q15_Obj *obj = (VIB_COMP_Q15_Obj *)handle;
+    float32_t scaleNew_A = IqMax_A / 32768.0f;
+    float32_t rescale;
+    float32_t value;
+    int16_t cnt;
+
+    if((band >= VIB_COMP_Q15_BAND_NUM) || (IqMax_A <= 0.0f))
+    {
+        return;
+    }
+
+    // rescale the learned values, a table without a scale yet is empty
+    if(obj->scale_A[band] > 0.0f)
+    {
+        rescale = obj->scale_A[band] / scaleNew_A;
+
+        for(cnt = 0; cnt < (int16_t)VIB_COMP_BUF_SIZE; cnt++)
+        {
+            value = rescale * (float32_t)obj->FF_table[band][cnt];
+            value += (value < 0.0f) ? -0.5f : 0.5f;
+
+            obj->FF_table[band][cnt] = (int16_t)MATH_sat(value,
+                                                         32767.0f, -32768.0f);
+        }
+    }
+
+    obj->scale_A[band] = scaleNew_A;
+    obj->scaleInv[band] = 32768.0f / IqMax_A;
+
+    return;
+} // end of VIB_COMP_Q15_setScale() function
+
+void VIB_COMP_Q15_setParams(VIB_COMP_Q15_Handle handle,
+                            const float32_t alpha, const float32_t gain,
+                            const int16_t indexDelta,
+                            const uint16_t numPolePairs,
+                            const float32_t IqMax_A,
+                            const float32_t *pSpeedBand_Hz,
+                            const float32_t speedHyst_Hz)
+{
+    VIB_COMP_Q15_Obj *obj = (VIB_COMP_Q15_Obj *)handle;
+    uint16_t band;
+
+    obj->alpha = alpha * gain;
+    obj->beta = (1.0f - alpha) * gain;
+
+    obj->anglePairsMax = ((float32_t)numPolePairs) * MATH_TWO_PI;
+    obj->angleMechInvSf = 1.0f / ((float32_t)numPolePairs);
+    obj->indexSf = (float32_t)VIB_COMP_BUF_SIZE / MATH_TWO_PI;
+
+    obj->angleElecPrev_rad = 0.0f;
+    obj->angleMechPoles_rad = 0.0f;
+
+    obj->indexDelta = indexDelta;
+
+    for(band = 0; band < VIB_COMP_Q15_BAND_NUM; band++)
+    {
+        obj->scale_A[band] = 0.0f;
+        VIB_COMP_Q15_setScale(handle, band, IqMax_A);
+
+        // the last band has no upper speed limit
+        obj->speedBand_Hz[band] = ((band + 1U) < VIB_COMP_Q15_BAND_NUM) ?
+                                  pSpeedBand_Hz[band] : 0.0f;
+    }
+
+    obj->speedHyst_Hz = speedHyst_Hz;
+    obj->band = 0;
+
+    return;
+} // end of VIB_COMP_Q15_setParams() function
+
 // end of file
@@ -61,6 +61,15 @@ extern "C" {
 #endif
 
 
+//! \brief Defines the maximum number of points of a volts/hertz profile
+//!
+#define VS_FREQ_PROFILE_NUM_MAX     8
+
+//! \brief Defines the number of uniform segments of the profile table
+//!
+#define VS_FREQ_TABLE_SIZE          32
+
+
 //! \brief Defines the angle generator (ANGLE_COMP) object
 //!
 typedef struct _VS_FREQ_Obj_
@@ -76,6 +85,9 @@ typedef struct _VS_FREQ_Obj_
     float32_t   Vs_out;         //!< Output: Output voltage (pu)
     MATH_Vec2   Vdq_gain;       //!< Variable
     MATH_Vec2   Vdq_out;        //!< Output: Output voltage (pu)
+    float32_t   TableFreqStepInv;   //!< Parameter: Inverse of the table frequency step (1/pu)
+    float32_t   VsTable[VS_FREQ_TABLE_SIZE + 1];    //!< Parameter: Voltage at each table frequency (pu)
+    float32_t   VsDeltaTable[VS_FREQ_TABLE_SIZE];   //!< Parameter: Voltage change over each table segment (pu)
 } VS_FREQ_Obj;
 
 //! \brief Defines the VS_FREQ_obj handle
@@ -152,6 +164,48 @@ static inline void VS_FREQ_run(VS_FREQ_Handle handle,const float32_t Freq_pu)
 } // end of VS_FREQ_run()
 
 
+//! \brief     Generates an output command voltage for a specific
+//!            input command frequency from the profile table built by
+//!            VS_FREQ_setProfileTable()
+//! \param[in] handle     The volts/hertz profile (VS_FREQ) handle
+//! \param[in] fm_pu      The electrical speed in pu
+static inline void VS_FREQ_runTable(VS_FREQ_Handle handle,const float32_t Freq_pu)
+{
+    VS_FREQ_Obj *obj = (VS_FREQ_Obj *)handle;
+    float32_t tablePos;
+    int16_t index;
+
+    obj->Freq = fabsf(Freq_pu);
+
+    tablePos = obj->Freq * obj->TableFreqStepInv;
+
+    if(tablePos >= (float32_t)VS_FREQ_TABLE_SIZE)
+    {
+        obj->Vs_out = obj->VsTable[VS_FREQ_TABLE_SIZE];
+    }
+    else
+    {
+        index = (int16_t)tablePos;
+
+        obj->Vs_out = obj->VsTable[index] +
+                      obj->VsDeltaTable[index] * (tablePos - (float32_t)index);
+    }
+
+    obj->Vdq_out.value[0] = obj->Vs_out * obj->Vdq_gain.value[0];
+
+    if(obj->Freq > 0.0f)
+    {
+        obj->Vdq_out.value[1] = obj->Vs_out * obj->Vdq_gain.value[1];
+    }
+    else
+    {
+        obj->Vdq_out.value[1] = -obj->Vs_out * obj->Vdq_gain.value[1];
+    }
+
+    return;
+} // end of VS_FREQ_runTable()
+
+
 //! \brief     Sets the parameters VsMag_pu
 //! \param[in] handle               The volts/hertz profile (VS_FREQ) handle
 //! \param[in] maxVsMag_pu          The maixmum magintude for volts/hertz profile, pu
@@ -190,6 +244,29 @@ extern void VS_FREQ_setProfile(VS_FREQ_Handle handle,
                                float32_t VoltMin, float32_t VoltMax);
 
 
+//! \brief     Builds the profile table of VS_FREQ_runTable() from a
+//!            multi-point volts/hertz profile
+//! \details   The profile is linear between the points, holds the first
+//!            voltage below the first frequency and the last voltage above
+//!            the last frequency. It is sampled at VS_FREQ_TABLE_SIZE uniform
+//!            steps up to the last frequency, so a corner that falls between
+//!            two steps is rounded off
+//!
+//!            The profile is rejected and the previous table kept when the
+//!            frequencies are not strictly ascending or the last one is not
+//!            above zero. The legacy parameters of VS_FREQ_run() follow the
+//!            profile end points
+//! \param[in] handle     The volts/hertz profile (VS_FREQ) handle
+//! \param[in] pFreq      The pointer to the ascending profile frequencies, pu
+//! \param[in] pVolt      The pointer to the profile voltages, pu
+//! \param[in] numPoints  The number of profile points, 2 to
+//!                       VS_FREQ_PROFILE_NUM_MAX
+extern void VS_FREQ_setProfileTable(VS_FREQ_Handle handle,
+                                    const float32_t *pFreq,
+                                    const float32_t *pVolt,
+                                    const uint16_t numPoints);
+
+
 #ifdef __cplusplus
 }
 #endif // extern "C"
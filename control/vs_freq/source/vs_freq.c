@@ -45,6 +45,27 @@
 #pragma CODE_SECTION(VS_FREQ_init,"Cla1Prog2");
 #endif
 
+// **************************************************************************
+// the functions
+
+//! \brief     Computes the Vd/Vq gains from the maximum voltage magnitude
+//! \param[in] obj                  The volts/hertz profile (VS_FREQ) object
+static void VS_FREQ_computeVdqGain(VS_FREQ_Obj *obj)
+{
+    obj->Vdq_gain.value[0] = 0.3f;
+
+#ifdef __TMS320C28XX_CLA__
+    obj->Vdq_gain.value[1] = CLAsqrt_inline(obj->maxVsMag_pu * obj->maxVsMag_pu -
+                                 obj->Vdq_gain.value[0] * obj->Vdq_gain.value[0]);
+#else
+    obj->Vdq_gain.value[1] = sqrtf(obj->maxVsMag_pu * obj->maxVsMag_pu -
+                               obj->Vdq_gain.value[0] * obj->Vdq_gain.value[0]);
+#endif // __TMS320C28XX_CLA__
+
+    return;
+} // end of VS_FREQ_computeVdqGain() function
+
+
 //*****************************************************************************
 //
 // VS_FREQ_init
@@ -85,17 +106,94 @@ void VS_FREQ_setProfile(VS_FREQ_Handle handle,
 
     obj->VfSlope = (obj->VoltMax - obj->VoltMin)/(obj->HighFreq - obj->LowFreq);
 
-    obj->Vdq_gain.value[0] = 0.3f;
-
-#ifdef __TMS320C28XX_CLA__
-    obj->Vdq_gain.value[1] = CLAsqrt_inline(obj->maxVsMag_pu * obj->maxVsMag_pu -
-                                 obj->Vdq_gain.value[0] * obj->Vdq_gain.value[0]);
-#else
-    obj->Vdq_gain.value[1] = sqrtf(obj->maxVsMag_pu * obj->maxVsMag_pu -
-                               obj->Vdq_gain.value[0] * obj->Vdq_gain.value[0]);
-#endif // __TMS320C28XX_CLA__
+    VS_FREQ_computeVdqGain(obj);
 
   return;
 } // end of VS_FREQ_setProfile() function
 
+
+//! \brief     Sets the parameters of a multi-point profile
+//! \param[in] handle               The volts/hertz profile (VS_FREQ) handle
+//! \param[in] pFreq                The strictly ascending profile frequencies, pu,
+//!                                 the last one above zero
+//! \param[in] pVolt                The profile voltages, pu
+//! \param[in] numPoints            The number of profile points
+void VS_FREQ_setProfileTable(VS_FREQ_Handle handle,
+                             const float32_t *pFreq,
+                             const float32_t *pVolt,
+                             const uint16_t numPoints)
+{
+    VS_FREQ_Obj *obj = (VS_FREQ_Obj *)handle;
+    uint16_t num = (numPoints > VS_FREQ_PROFILE_NUM_MAX) ?
+                   VS_FREQ_PROFILE_NUM_MAX : numPoints;
+    uint16_t point = 0;
+    uint16_t cnt;
+    float32_t freqStep;
+    float32_t freq;
+
+    // the table is kept as it is for a profile that can't be sampled, fewer
+    // than two points, a zero end frequency or frequencies not ascending
+    if((num < 2) || (pFreq[num - 1] <= 0.0f))
+    {
+        return;
+    }
+
+    for(cnt = 1; cnt < num; cnt++)
+    {
+        if(pFreq[cnt] <= pFreq[cnt - 1])
+        {
+            return;
+        }
+    }
+
+    freqStep = pFreq[num - 1] / (float32_t)VS_FREQ_TABLE_SIZE;
+    obj->TableFreqStepInv = 1.0f / freqStep;
+
+    // sample the piecewise linear profile at each table frequency
+    for(cnt = 0; cnt <= VS_FREQ_TABLE_SIZE; cnt++)
+    {
+        freq = freqStep * (float32_t)cnt;
+
+        while((point < (num - 2)) && (freq > pFreq[point + 1]))
+        {
+            point++;
+        }
+
+        if(freq <= pFreq[0])
+        {
+            obj->VsTable[cnt] = pVolt[0];
+        }
+        else if(cnt == VS_FREQ_TABLE_SIZE)
+        {
+            obj->VsTable[cnt] = pVolt[num - 1];
+        }
+        else
+        {
+            obj->VsTable[cnt] = pVolt[point] +
+                                (pVolt[point + 1] - pVolt[point]) *
+                                (freq - pFreq[point]) /
+                                (pFreq[point + 1] - pFreq[point]);
+        }
+    }
+
+    for(cnt = 0; cnt < VS_FREQ_TABLE_SIZE; cnt++)
+    {
+        obj->VsDeltaTable[cnt] = obj->VsTable[cnt + 1] - obj->VsTable[cnt];
+    }
+
+    // keep the legacy parameters on the profile end points
+    obj->LowFreq = pFreq[0];
+    obj->HighFreq = pFreq[num - 1];
+    obj->VoltMin = pVolt[0];
+    obj->VoltMax = pVolt[num - 1];
+
+    // the end points are strictly ascending, so VS_FREQ_run() gets the slope
+    // of this profile
+    obj->VfSlope = (obj->VoltMax - obj->VoltMin)/(obj->HighFreq - obj->LowFreq);
+
+    VS_FREQ_computeVdqGain(obj);
+
+    return;
+} // end of VS_FREQ_setProfileTable() function
+
 // end of the file
@@ -83,6 +83,27 @@ extern "C"
 #define VSF_NUM_MIN_FREQ_HZ        5000
 
 
+//! \brief Defines the frequency step of the PWM period table, 2^n Hz
+//!
+#define VSF_PERIOD_TABLE_SHIFT     6
+
+
+//! \brief Defines the cpu frequency of the PWM period table, Hz
+//!
+#define VSF_PERIOD_TABLE_CPU_FREQ_HZ   (200000000UL)
+
+
+//! \brief Defines the number of entries of the PWM period table
+//!
+#define VSF_PERIOD_TABLE_SIZE      (((VSF_NUM_MAX_FREQ_HZ - VSF_NUM_MIN_FREQ_HZ)  \
+                                     >> VSF_PERIOD_TABLE_SHIFT) + 2)
+
+
+//! \brief Defines the maximum number of operating point bands
+//!
+#define VSF_NUM_SCHED_BANDS        4
+
+
 
 // the typedefs
 typedef enum
@@ -94,6 +115,15 @@ typedef enum
     VSF_STATE_ALL_DONE = 4         // N/A
 } VSF_State_e;
 
+//! \brief Defines an operating point band of the frequency schedule
+//!
+typedef struct _VSF_SchedBand_
+{
+    float32_t speedMax_Hz;        //!< Defines the maximum speed of the band, Hz
+    float32_t currentMax_A;       //!< Defines the maximum current of the band, A
+    uint16_t  pwmFreq_Hz;         //!< Defines the pwm frequency of the band, Hz
+} VSF_SchedBand;
+
 //! \brief Defines the VSF handle
 //!
 typedef struct _VSF_Obj_
@@ -112,6 +142,17 @@ typedef struct _VSF_Obj_
     uint16_t  pwmCounter;         //!< Define the counter for wait time
 
     uint32_t  cpuFreq_Hz;         //!< Defines the cpu frequency, Hz
+
+    uint32_t  pwmPeriodScale;     //!< Defines the ratio of cpuFreq_Hz to
+                                  //!< VSF_PERIOD_TABLE_CPU_FREQ_HZ, Q16
+
+    VSF_SchedBand sched[VSF_NUM_SCHED_BANDS];
+                                  //!< Defines the operating point bands
+    float32_t schedSpeedHyst_Hz;  //!< Defines the speed hysteresis, Hz
+    float32_t schedCurrentHyst_A; //!< Defines the current hysteresis, A
+    uint16_t  schedNumBands;      //!< Defines the number of bands in use
+    uint16_t  schedBand;          //!< Defines the present band
+    bool      flagEnableSched;    //!< Defines the enable flag of the schedule
 }VSF_Obj;
 
 //! \brief Defines the online variable switching frequency (VSF) handle
@@ -120,6 +161,10 @@ typedef struct _VSF_Obj_ *VSF_Handle;
 
 // the globals
 
+//! \brief Defines the PWM period table at VSF_PERIOD_TABLE_CPU_FREQ_HZ, shared
+//!        by all the VSF objects
+extern const uint16_t VSF_periodTable[VSF_PERIOD_TABLE_SIZE];
+
 
 // the functions
 
@@ -142,6 +187,92 @@ extern void VSF_initParams(VSF_Handle vsfHandle, USER_Params *pUserParams);
 extern void VSF_computeFreqParams(VSF_Handle vsfHandle);
 
 
+//! \brief     Computes the scale of the shared PWM period table from the cpu
+//!            frequency
+//! \param[in] vsfHandle  The variable switching frequency object handle
+extern void VSF_computePeriodScale(VSF_Handle vsfHandle);
+
+
+//! \brief     Sets the operating point bands of the frequency schedule
+//! \param[in] vsfHandle      The variable switching frequency object handle
+//! \param[in] pSched         The pointer to the bands, ordered from light to
+//!                           heavy load, the last band covers all the rest
+//! \param[in] numBands       The number of bands
+//! \param[in] speedHyst_Hz   The speed hysteresis to return to a lower band
+//! \param[in] currentHyst_A  The current hysteresis to return to a lower band
+extern void VSF_setSchedParams(VSF_Handle vsfHandle,
+                               const VSF_SchedBand *pSched,
+                               const uint16_t numBands,
+                               const float32_t speedHyst_Hz,
+                               const float32_t currentHyst_A);
+
+
+//! \brief     Selects the PWM frequency from the operating point bands
+//! \details   The first band that covers the speed and current sets the
+//!            frequency. Runs in background before VSF_computeFreqParams()
+//! \param[in] vsfHandle  The variable switching frequency object handle
+//! \param[in] speed_Hz   The motor speed, Hz
+//! \param[in] Is_A       The stator current amplitude, A
+extern void VSF_runSched(VSF_Handle vsfHandle,
+                         const float32_t speed_Hz, const float32_t Is_A);
+
+
+//! \brief     Get the PWM period of a switching frequency from the table
+//! \details   Interpolates between the entries of the shared table and scales
+//!            the result to the cpu frequency, within two counts of
+//!            (cpuFreq_Hz / 2) / freq_Hz up to a 200MHz cpu frequency
+//! \param[in] The variable switching frequency (VSF) object handle
+//! \param[in] The pwm switching frequency, limited to the table range
+//! \return    The pwm period register value
+inline uint16_t VSF_computePeriod(VSF_Handle vsfHandle, const uint16_t freq_Hz)
+{
+    VSF_Obj *vsfObj = (VSF_Obj *)vsfHandle;
+    uint16_t freqDelta_Hz;
+    uint16_t index;
+    uint16_t frac;
+    uint16_t period0;
+    uint16_t period1;
+    uint16_t periodRef;
+
+    if(freq_Hz <= VSF_NUM_MIN_FREQ_HZ)
+    {
+        freqDelta_Hz = 0;
+    }
+    else if(freq_Hz >= VSF_NUM_MAX_FREQ_HZ)
+    {
+        freqDelta_Hz = VSF_NUM_MAX_FREQ_HZ - VSF_NUM_MIN_FREQ_HZ;
+    }
+    else
+    {
+        freqDelta_Hz = freq_Hz - VSF_NUM_MIN_FREQ_HZ;
+    }
+
+    index = freqDelta_Hz >> VSF_PERIOD_TABLE_SHIFT;
+    frac = freqDelta_Hz & ((1 << VSF_PERIOD_TABLE_SHIFT) - 1);
+
+    period0 = VSF_periodTable[index];
+    period1 = VSF_periodTable[index + 1];
+
+    periodRef = period0 - (uint16_t)((((uint32_t)(period0 - period1) * frac) +
+                                      (1 << (VSF_PERIOD_TABLE_SHIFT - 1))) >>
+                                     VSF_PERIOD_TABLE_SHIFT);
+
+    return((uint16_t)(((uint32_t)periodRef * vsfObj->pwmPeriodScale +
+                       0x8000UL) >> 16));
+}
+
+
+//! \brief     Get the present operating point band
+//! \param[in] The variable switching frequency (VSF) object handle
+//! \return    The present band of the frequency schedule
+inline uint16_t VSF_getSchedBand(VSF_Handle vsfHandle)
+{
+    VSF_Obj *vsfObj = (VSF_Obj *)vsfHandle;
+
+    return(vsfObj->schedBand);
+}
+
+
 //! \brief     Get the current switching frequency
 //! \param[in] The variable switching frequency (VSF) object handle
 //! \return    The current pwm frequency
@@ -229,6 +360,11 @@ inline void VSF_setFreqMin(VSF_Handle vsfHandle, const uint16_t pwmFreqMin_Hz)
 
 
 //! \brief     Set the variable switching frequency PWM period
+//! \details   Moves pwmPeriodNow one count per call toward the period that
+//!            VSF_computeFreqParams() takes from VSF_periodTable[]. Only the
+//!            frequency to period conversion is tabulated, the ramp is not,
+//!            since its step is one compare and one increment and a ramp table
+//!            would add a load and an index check to the ISR
 //! \param[in] The variable switching frequency (VSF) object handle
 inline void VSF_setPeriod(VSF_Handle vsfHandle)
 {
@@ -273,6 +409,18 @@ inline void VSF_setState(VSF_Handle vsfHandle, const VSF_State_e state)
     return;
 }
 
+//! \brief     Enable or disable the operating point frequency schedule
+//! \param[in] The variable switching frequency (VSF) object handle
+//! \param[in] The enable flag of the schedule
+inline void VSF_setFlag_enableSched(VSF_Handle vsfHandle, const bool flag)
+{
+    VSF_Obj *vsfObj = (VSF_Obj *)vsfHandle;
+
+    vsfObj->flagEnableSched = flag;
+
+    return;
+}
+
 //! \brief     Set the variable switching frequency wait time
 //! \param[in] The variable switching frequency (VSF) object handle
 //! \param[in] The variable switching frequency wait time
@@ -51,6 +51,52 @@
 // **************************************************************************
 // the globals
 
+// PWM periods at VSF_PERIOD_TABLE_CPU_FREQ_HZ, from VSF_NUM_MIN_FREQ_HZ in steps
+// of 2^VSF_PERIOD_TABLE_SHIFT Hz, (VSF_PERIOD_TABLE_CPU_FREQ_HZ / 2) / f rounded
+const uint16_t VSF_periodTable[VSF_PERIOD_TABLE_SIZE] =
+{
+    20000, 19747, 19501, 19260, 19026, 18797, 18574, 18355,
+    18142, 17934, 17730, 17532, 17337, 17147, 16961, 16779,
+    16600, 16426, 16255, 16088, 15924, 15763, 15605, 15451,
+    15300, 15152, 15006, 14863, 14723, 14586, 14451, 14318,
+    14188, 14061, 13935, 13812, 13691, 13572, 13455, 13340,
+    13228, 13116, 13007, 12900, 12794, 12690, 12588, 12488,
+    12389, 12291, 12195, 12101, 12008, 11916, 11826, 11737,
+    11650, 11563, 11478, 11395, 11312, 11231, 11151, 11072,
+    10994, 10917, 10841, 10767, 10693, 10620, 10549, 10478,
+    10408, 10339, 10271, 10204, 10138, 10073, 10008,  9944,
+     9881,  9819,  9758,  9697,  9638,  9579,  9520,  9463,
+     9406,  9349,  9294,  9239,  9184,  9131,  9078,  9025,
+     8973,  8922,  8872,  8821,  8772,  8723,  8675,  8627,
+     8579,  8532,  8486,  8440,  8395,  8350,  8306,  8262,
+     8218,  8175,  8133,  8091,  8049,  8008,  7967,  7926,
+     7886,  7847,  7808,  7769,  7730,  7692,  7655,  7617,
+     7580,  7544,  7508,  7472,  7436,  7401,  7366,  7331,
+     7297,  7263,  7230,  7196,  7163,  7131,  7098,  7066,
+     7034,  7003,  6972,  6941,  6910,  6879,  6849,  6819,
+     6790,  6760,  6731,  6702,  6674,  6645,  6617,  6589,
+     6562,  6534,  6507,  6480,  6453,  6427,  6400,  6374,
+     6348,  6323,  6297,  6272,  6247,  6222,  6197,  6173,
+     6149,  6124,  6101,  6077,  6053,  6030,  6007,  5984,
+     5961,  5938,  5916,  5893,  5871,  5849,  5828,  5806,
+     5784,  5763,  5742,  5721,  5700,  5679,  5659,  5638,
+     5618,  5598,  5578,  5558,  5538,  5519,  5499,  5480,
+     5461,  5442,  5423,  5404,  5386,  5367,  5349,  5330,
+     5312,  5294,  5276,  5259,  5241,  5224,  5206,  5189,
+     5172,  5155,  5138,  5121,  5104,  5088,  5071,  5055,
+     5038,  5022,  5006,  4990,  4974,  4958,  4943,  4927,
+     4912,  4896,  4881,  4866,  4851,  4836,  4821,  4806,
+     4791,  4776,  4762,  4747,  4733,  4719,  4705,  4690,
+     4676,  4662,  4649,  4635,  4621,  4607,  4594,  4580,
+     4567,  4554,  4541,  4527,  4514,  4501,  4488,  4475,
+     4463,  4450,  4437,  4425,  4412,  4400,  4388,  4375,
+     4363,  4351,  4339,  4327,  4315,  4303,  4291,  4279,
+     4268,  4256,  4244,  4233,  4222,  4210,  4199,  4188,
+     4176,  4165,  4154,  4143,  4132,  4121,  4110,  4100,
+     4089,  4078,  4068,  4057,  4047,  4036,  4026,  4015,
+     4005,  3995
+};
+
 
 // **************************************************************************
 // the functions
@@ -91,6 +137,14 @@ void VSF_initParams(VSF_Handle vsfHandle, USER_Params *pUserParams)
     vsfObj->pwmWaitTime = VSF_NUM_WAIT_TIME;
     vsfObj->pwmCounter = 0;
 
+    VSF_computePeriodScale(vsfHandle);
+
+    vsfObj->schedSpeedHyst_Hz = 0.0f;
+    vsfObj->schedCurrentHyst_A = 0.0f;
+    vsfObj->schedNumBands = 0;
+    vsfObj->schedBand = 0;
+    vsfObj->flagEnableSched = false;
+
     vsfObj->state = VSF_STATE_IDLE;
 
     return;
@@ -139,7 +193,8 @@ void VSF_computeFreqParams(VSF_Handle vsfHandle)
                 }
             }
 
-            vsfObj->pwmPeriod = (vsfObj->cpuFreq_Hz>>1) / vsfObj->pwmFreqNow_Hz;
+            vsfObj->pwmPeriod = VSF_computePeriod(vsfHandle,
+                                                  vsfObj->pwmFreqNow_Hz);
             vsfObj->state = VSF_STATE_PERIOD_SET;
         }
     }
@@ -147,4 +202,81 @@ void VSF_computeFreqParams(VSF_Handle vsfHandle)
     return;
 }
 
+
+void VSF_computePeriodScale(VSF_Handle vsfHandle)
+{
+    VSF_Obj *vsfObj = (VSF_Obj *)vsfHandle;
+
+    // the table is shared in flash, only the cpu frequency ratio is per object
+    vsfObj->pwmPeriodScale = (uint32_t)(((uint64_t)vsfObj->cpuFreq_Hz << 16) /
+                                        VSF_PERIOD_TABLE_CPU_FREQ_HZ);
+
+    return;
+}
+
+
+void VSF_setSchedParams(VSF_Handle vsfHandle,
+                        const VSF_SchedBand *pSched,
+                        const uint16_t numBands,
+                        const float32_t speedHyst_Hz,
+                        const float32_t currentHyst_A)
+{
+    VSF_Obj *vsfObj = (VSF_Obj *)vsfHandle;
+    uint16_t band;
+
+    vsfObj->schedNumBands = (numBands < VSF_NUM_SCHED_BANDS) ?
+                            numBands : VSF_NUM_SCHED_BANDS;
+
+    for(band = 0; band < vsfObj->schedNumBands; band++)
+    {
+        vsfObj->sched[band] = pSched[band];
+    }
+
+    vsfObj->schedSpeedHyst_Hz = speedHyst_Hz;
+    vsfObj->schedCurrentHyst_A = currentHyst_A;
+
+    // start from the heaviest load band
+    vsfObj->schedBand = (vsfObj->schedNumBands > 0) ?
+                        (vsfObj->schedNumBands - 1) : 0;
+
+    return;
+}
+
+
+void VSF_runSched(VSF_Handle vsfHandle,
+                  const float32_t speed_Hz, const float32_t Is_A)
+{
+    VSF_Obj *vsfObj = (VSF_Obj *)vsfHandle;
+    float32_t speedAbs_Hz = MATH_abs(speed_Hz);
+    float32_t speedHyst_Hz;
+    float32_t currentHyst_A;
+    uint16_t band;
+
+    if((vsfObj->flagEnableSched == false) || (vsfObj->schedNumBands == 0))
+    {
+        return;
+    }
+
+    // Find the first band covering the operating point, the last band covers
+    // all the rest. A lower band than the present one needs the hysteresis
+    for(band = 0; band < (vsfObj->schedNumBands - 1); band++)
+    {
+        speedHyst_Hz = (band < vsfObj->schedBand) ?
+                       vsfObj->schedSpeedHyst_Hz : 0.0f;
+        currentHyst_A = (band < vsfObj->schedBand) ?
+                        vsfObj->schedCurrentHyst_A : 0.0f;
+
+        if((speedAbs_Hz <= (vsfObj->sched[band].speedMax_Hz - speedHyst_Hz)) &&
+           (Is_A <= (vsfObj->sched[band].currentMax_A - currentHyst_A)))
+        {
+            break;
+        }
+    }
+
+    vsfObj->schedBand = band;
+    vsfObj->pwmFreqSet_Hz = vsfObj->sched[band].pwmFreq_Hz;
+
+    return;
+}
+
 // end of file
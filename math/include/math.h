@@ -207,6 +207,13 @@ extern "C"
 //*****************************************************************************
 #define MATH_PI_OVER_FOUR_PU        ((float32_t)(0.125f))
 
+//*****************************************************************************
+//
+//! \brief Defines the number of entries of the reciprocal seed table
+//
+//*****************************************************************************
+#define MATH_RECIP_TABLE_SIZE      64
+
 //*****************************************************************************
 //
 //! \brief Defines a two element vector
@@ -377,6 +384,59 @@ MATH_sat(const float32_t in, const float32_t max, const float32_t min)
     return(out);
 } // end of MATH_sat() function
 
+#ifndef __TMS320C28XX_CLA__
+//*****************************************************************************
+//
+//! \brief The reciprocal seed table, 64 / (64 + n)
+//
+//*****************************************************************************
+extern const float32_t MATH_recipTable[MATH_RECIP_TABLE_SIZE];
+
+//*****************************************************************************
+//
+//! \brief     Computes the reciprocal of an integer without a division
+//!
+//!            The value is normalized by powers of 2 into the range of the
+//!            seed table, and the table seed is refined by two
+//!            Newton-Raphson steps
+//!
+//! \param[in] value  The input value, greater than 0
+//!
+//! \return    The reciprocal, 1/value
+//
+//*****************************************************************************
+static inline float32_t
+MATH_getRecip(const uint32_t value)
+{
+    uint32_t valueNorm = value;
+    float32_t scale = 1.0f / (float32_t)MATH_RECIP_TABLE_SIZE;
+    float32_t valueF = (float32_t)value;
+    float32_t recip;
+
+    //
+    // Normalize the value to MATH_RECIP_TABLE_SIZE ~ 2 * MATH_RECIP_TABLE_SIZE
+    //
+    while(valueNorm >= (2 * MATH_RECIP_TABLE_SIZE))
+    {
+        valueNorm = valueNorm >> 1;
+        scale = scale * 0.5f;
+    }
+
+    while(valueNorm < MATH_RECIP_TABLE_SIZE)
+    {
+        valueNorm = valueNorm << 1;
+        scale = scale * 2.0f;
+    }
+
+    recip = MATH_recipTable[valueNorm - MATH_RECIP_TABLE_SIZE] * scale;
+
+    recip = recip * (2.0f - valueF * recip);
+    recip = recip * (2.0f - valueF * recip);
+
+    return(recip);
+} // end of MATH_getRecip() function
+#endif // __TMS320C28XX_CLA__
+
 //----------------------------------------------------------------------------
 // For Motor Fault Diagnostic
 //-----------------------------------------------------------------------------
@@ -0,0 +1,77 @@
+//#############################################################################
+//
+// FILE:   math.c
+//
+// TITLE:  C28x math library (floating point)
+//
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+
+//! \file   libraries/math/source/math.c
+//! \brief  Contains the tables of the math library
+//!
+
+
+// **************************************************************************
+// the includes
+#include "libraries/math/include/math.h"
+
+
+// **************************************************************************
+// the globals
+
+//! \brief The reciprocal seed table, 64 / (64 + n)
+//!
+const float32_t MATH_recipTable[MATH_RECIP_TABLE_SIZE] =
+{
+    1.00000000f, 0.98461538f, 0.96969697f, 0.95522388f,
+    0.94117647f, 0.92753623f, 0.91428571f, 0.90140845f,
+    0.88888889f, 0.87671233f, 0.86486486f, 0.85333333f,
+    0.84210526f, 0.83116883f, 0.82051282f, 0.81012658f,
+    0.80000000f, 0.79012346f, 0.78048780f, 0.77108434f,
+    0.76190476f, 0.75294118f, 0.74418605f, 0.73563218f,
+    0.72727273f, 0.71910112f, 0.71111111f, 0.70329670f,
+    0.69565217f, 0.68817204f, 0.68085106f, 0.67368421f,
+    0.66666667f, 0.65979381f, 0.65306122f, 0.64646465f,
+    0.64000000f, 0.63366337f, 0.62745098f, 0.62135922f,
+    0.61538462f, 0.60952381f, 0.60377358f, 0.59813084f,
+    0.59259259f, 0.58715596f, 0.58181818f, 0.57657658f,
+    0.57142857f, 0.56637168f, 0.56140351f, 0.55652174f,
+    0.55172414f, 0.54700855f, 0.54237288f, 0.53781513f,
+    0.53333333f, 0.52892562f, 0.52459016f, 0.52032520f,
+    0.51612903f, 0.51200000f, 0.50793651f, 0.50393701f
+};
+
+
+// end of file
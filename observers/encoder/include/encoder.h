@@ -74,6 +74,9 @@ extern "C"
 // the defines
 //#define ENC_CALIB       1
 
+//! \brief Defines the default capture timer prescaler of the M/T speed
+#define ENC_MT_CAP_PRESCALER    128
+
 // **************************************************************************
 // the typedefs
 
@@ -106,6 +109,15 @@ typedef struct _ENC_Obj_  //编码器对象结构体
 
     float32_t speedElec_Hz;         // target speed //目标速度
     float32_t speedMech_Hz;         // estimated rotor speed //测量转速
+    float32_t speedMTScaler;        // system clock / (4 * encoder lines), Hz
+
+    uint32_t  unitPeriod_cnt;       // unit timer period, system clock counts
+    uint32_t  windowTicks;          // system clock counts since the last edge window
+    uint32_t  posMax;               // QEP counts per mechanical revolution
+    uint32_t  posLatchPrev;         // position latch of the last edge window
+    uint16_t  capPrescaler;         // capture timer prescaler
+    uint16_t  capTimerPrev;         // capture timer latch of the last edge window
+    bool      flagSpeedMTInit;      // the M/T speed windows are seeded
 
     uint32_t  qepHandle;            // the QEP handle //正交脉冲句柄
     uint32_t  indexOffset;          // the offset of index 
@@ -144,6 +156,33 @@ extern ENC_Handle ENC_init(void *pMemory, const size_t numBytes);
 //! \param[in] handle      The ENC controller handle
 extern void ENC_setParams(ENC_Handle handle, const USER_Params *pUserParams);
 
+//! \brief     Sets the M/T speed parameters, must match the EQEP setup
+//! \param[in] handle          The ENC controller handle
+//! \param[in] unitPeriod_cnt  The unit timer period (QUPRD), system clock counts
+//! \param[in] capPrescaler    The capture timer prescaler, 1 ~ 128
+extern void ENC_setSpeedMTParams(ENC_Handle handle,
+                                 const uint32_t unitPeriod_cnt,
+                                 const uint16_t capPrescaler);
+
+//! \brief     Resets the M/T speed, the next edge window seeds the estimator
+//! \param[in] handle      The ENC controller handle
+extern void ENC_resetSpeedMT(ENC_Handle handle);
+
+//! \brief     Computes the M/T speed from one unit timer window
+//! \details   The speed is the QEP count change over the exact time between
+//!            the last edges of two windows, the window time plus the capture
+//!            timer latches. A window without an edge only bounds the speed
+//!            to one count over the time since the last edge
+//! \param[in] handle           The ENC controller handle
+//! \param[in] posLatch         The position counter latched on unit time out
+//! \param[in] capTimer         The capture timer latched on unit time out
+//! \param[in] flagCapOverflow  The capture timer has overflowed
+//! \param[in] flagCapDirError  The direction changed between the edges
+extern void ENC_calcSpeedMT(ENC_Handle handle, const uint32_t posLatch,
+                            const uint16_t capTimer,
+                            const bool flagCapOverflow,
+                            const bool flagCapDirError);
+
 //! \brief     Runs the ENC controller
 //! \param[in] handle      The ENC controller handle
 //! \return    speed from encoder //返回速度的句柄
@@ -154,6 +193,16 @@ static inline float32_t ENC_getSpeedElec_Hz(ENC_Handle handle)
     return(obj->speedElec_Hz);
 }
 
+//! \brief     Gets the mechanical speed from encoder
+//! \param[in] handle      The ENC controller handle
+//! \return    The mechanical speed, Hz
+static inline float32_t ENC_getSpeedMech_Hz(ENC_Handle handle)
+{
+    ENC_Obj *obj = (ENC_Obj *)handle;
+
+    return(obj->speedMech_Hz);
+}
+
 //! \brief     gets the angle from encoder
 //! \param[in] handle      The ENC controller handle
 //! \return    angle from encoder //返回电角度
@@ -398,6 +447,32 @@ static inline void ENC_runHall(ENC_Handle handle)
     return;
 }
 
+//! \brief     Runs the M/T speed of the ENC controller on a unit time out
+//! \details   The EQEP must latch on unit time out (QCLM = 1) with the unit
+//!            position event on every QEP count
+//! \param[in] handle  The ENC controller handle
+static inline void ENC_runSpeed(ENC_Handle handle)
+{
+    ENC_Obj *obj = (ENC_Obj *)handle;
+
+    if(EQEP_getInterruptStatus(obj->qepHandle) & EQEP_INT_UNIT_TIME_OUT)
+    {
+        uint16_t status = EQEP_getStatus(obj->qepHandle);
+
+        ENC_calcSpeedMT(handle, EQEP_getPositionLatch(obj->qepHandle),
+                        EQEP_getCaptureTimerLatch(obj->qepHandle),
+                        ((status & EQEP_STS_CAP_OVRFLW_ERROR) != 0),
+                        ((status & EQEP_STS_CAP_DIR_ERROR) != 0));
+
+        EQEP_clearStatus(obj->qepHandle,
+                         (EQEP_STS_CAP_OVRFLW_ERROR | EQEP_STS_CAP_DIR_ERROR));
+
+        EQEP_clearInterruptStatus(obj->qepHandle, EQEP_INT_UNIT_TIME_OUT);
+    }
+
+    return;
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
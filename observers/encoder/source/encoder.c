@@ -44,6 +44,7 @@
 // the defines
 
 #pragma CODE_SECTION(ENC_full_run, ".TI.ramfunc");
+#pragma CODE_SECTION(ENC_calcSpeedMT, ".TI.ramfunc");
 
 // **************************************************************************
 // the globals
@@ -52,6 +53,7 @@
 // **************************************************************************
 // the functions
 
+//------------------------------------------------------------------------------
 ENC_Handle ENC_init(void *pMemory, const size_t numBytes)
 {
 	ENC_Handle handle;
@@ -92,11 +94,122 @@ void ENC_setParams(ENC_Handle handle, const USER_Params *pUserParams)
 
     obj->mechanicalScaler = 0.25f / obj->encLines;
 
+    obj->posMax = 4 * (uint32_t)pUserParams->motor_numEncSlots;
+    obj->speedMTScaler = pUserParams->systemFreq_MHz * 1000000.0f *
+                         obj->mechanicalScaler;
+
+    ENC_setSpeedMTParams(handle,
+                         (uint32_t)(pUserParams->ctrlPeriod_sec *
+                                    pUserParams->systemFreq_MHz * 1000000.0f + 0.5f),
+                         ENC_MT_CAP_PRESCALER);
+
     obj->encState = ENC_IDLE;
 
     return;
 }
 
+//------------------------------------------------------------------------------
+void ENC_setSpeedMTParams(ENC_Handle handle, const uint32_t unitPeriod_cnt,
+                          const uint16_t capPrescaler)
+{
+    ENC_Obj *obj = (ENC_Obj *)handle;
+
+    obj->unitPeriod_cnt = unitPeriod_cnt;
+    obj->capPrescaler = capPrescaler;
+
+    ENC_resetSpeedMT(handle);
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+void ENC_resetSpeedMT(ENC_Handle handle)
+{
+    ENC_Obj *obj = (ENC_Obj *)handle;
+
+    obj->windowTicks = 0;
+    obj->capTimerPrev = 0;
+    obj->flagSpeedMTInit = false;
+
+    obj->speedMech_Hz = 0.0f;
+    obj->speedElec_Hz = 0.0f;
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+void ENC_calcSpeedMT(ENC_Handle handle, const uint32_t posLatch,
+                     const uint16_t capTimer, const bool flagCapOverflow,
+                     const bool flagCapDirError)
+{
+    ENC_Obj *obj = (ENC_Obj *)handle;
+
+    int32_t deltaPos = (int32_t)(posLatch - obj->posLatchPrev);
+    float32_t speedMech_Hz = obj->speedMech_Hz;
+    uint32_t ticks;
+
+    // the position counter rolls over at posMax
+    if(deltaPos > (int32_t)(obj->posMax >> 1))
+    {
+        deltaPos -= (int32_t)obj->posMax;
+    }
+    else if(deltaPos < -(int32_t)(obj->posMax >> 1))
+    {
+        deltaPos += (int32_t)obj->posMax;
+    }
+
+    obj->windowTicks += obj->unitPeriod_cnt;
+
+    if(flagCapOverflow == true)
+    {
+        // no edge for a full capture timer period, the rotor is standing
+        obj->posLatchPrev = posLatch;
+        obj->flagSpeedMTInit = false;
+
+        speedMech_Hz = 0.0f;
+    }
+    else if(deltaPos != 0)
+    {
+        if(obj->flagSpeedMTInit == true)
+        {
+            ticks = obj->windowTicks;
+
+            // move both window ends back onto the last QEP edge
+            if(flagCapDirError == false)
+            {
+                ticks += ((uint32_t)obj->capTimerPrev -
+                          (uint32_t)capTimer) * obj->capPrescaler;
+            }
+
+            if(ticks > 0)
+            {
+                speedMech_Hz = obj->speedMTScaler * (float32_t)deltaPos *
+                               MATH_getRecip(ticks);
+            }
+        }
+
+        obj->posLatchPrev = posLatch;
+        obj->capTimerPrev = capTimer;
+        obj->windowTicks = 0;
+        obj->flagSpeedMTInit = true;
+    }
+    else if(obj->flagSpeedMTInit == true)
+    {
+        // no edge in this window, the speed is at most one count over the
+        // time since the last edge
+        ticks = obj->windowTicks + (uint32_t)obj->capTimerPrev * obj->capPrescaler;
+
+        float32_t speedMax_Hz = obj->speedMTScaler * MATH_getRecip(ticks);
+
+        speedMech_Hz = __fsat(speedMech_Hz, speedMax_Hz, -speedMax_Hz);
+    }
+
+    obj->speedMech_Hz = speedMech_Hz;
+    obj->speedElec_Hz = speedMech_Hz * obj->polePairs;
+
+    return;
+}
+
 //! \brief     Runs the ENC controller
 //! \param[in] handle  The ENC controller handle
 //! \param[in] pVabVec The reference value to the controller
@@ -79,6 +79,13 @@ extern "C"
 // **************************************************************************
 // the defines
 
+//! \brief Defines the number of segments of the angle offset table, the table
+//!        covers the absolute reference speed from 0 to 1 pu
+//!
+#ifndef ESMO_OFFSET_TABLE_SIZE
+#define ESMO_OFFSET_TABLE_SIZE      32
+#endif  // ESMO_OFFSET_TABLE_SIZE
+
 
 // the typedefs
 
@@ -133,6 +140,16 @@ typedef struct _ESMO_Obj_
 	float32_t thetaDelta;
     float32_t offsetSF;         // Scale factor
     float32_t offsetDelta;      // Offset delta
+    float32_t thetaOffset;      // PLL angle offset (pu), updated on change
+    float32_t speedRefOffset;   // reference speed of the angle offset (pu)
+    float32_t offsetHyst;       // reference speed band of the angle offset (pu)
+    bool      flagUpdateOffset; // forces an update of the angle offset
+    bool      flagEnableOffsetTable;    // uses the table for the angle offset
+    bool      flagOffsetTableValid;     // the table matches offsetTableSF and offsetTableKslf
+    float32_t offsetTableSF;    // offsetSF the angle offset table was computed with
+    float32_t offsetTableKslf;  // Kslf the angle offset table was computed with
+    float32_t offsetTableErr;   // maximum error of the angle offset table (pu)
+    float32_t offsetTable[ESMO_OFFSET_TABLE_SIZE + 1];  // angle offset (pu)
     float32_t thetaEst;
 
     float32_t speedRef;
@@ -273,6 +290,26 @@ static inline void ESMO_resetPLL(ESMO_Handle handle)
     return;
 }
 
+//! \brief     Computes the angle offset table for the ESMO controller
+//!            The table holds the angle offset of the PLL against the absolute
+//!            reference speed. It is calculated from offsetSF and Kslf, and
+//!            only rebuilt when either of them differs from the values the
+//!            table was last computed with. ESMO_updateFilterParams() and
+//!            ESMO_setOffsetCoef() call it while the table is enabled
+//! \param[in] handle      The ESMO controller handle
+extern void ESMO_computeOffsetTable(ESMO_Handle handle);
+
+
+//! \brief     Computes the maximum error of the angle offset table
+//!            The interpolation is compared against the exact arc tangent at
+//!            three points inside every segment. This is a one-off check for
+//!            the commissioning of offsetSF and Kslf, it is not called by the
+//!            ESMO functions. The result is read with
+//!            ESMO_getOffsetTableError_rad()
+//! \param[in] handle      The ESMO controller handle
+extern void ESMO_computeOffsetTableError(ESMO_Handle handle);
+
+
 //! \brief     Sets angle offset coefficient for the ESMO controller
 //! \param[in] handle    The ESMO controller handle
 //! \param[in] offsetSF    The angle offset coefficient
@@ -280,11 +317,67 @@ static inline void ESMO_setOffsetCoef(ESMO_Handle handle, const float32_t offset
 {
     ESMO_Obj *obj = (ESMO_Obj *)handle;
 
-    obj->offsetSF = offsetSF;
+    if(obj->offsetSF != offsetSF)
+    {
+        obj->offsetSF = offsetSF;
+        obj->flagUpdateOffset = true;
+    }
+
+    if(obj->flagEnableOffsetTable == true)
+    {
+        ESMO_computeOffsetTable(handle);
+    }
+
+    return;
+}
+
+//! \brief     Sets the reference speed band of the angle offset update
+//!            The angle offset of the PLL is only recalculated when the
+//!            reference speed moves more than the band from the speed of the
+//!            last update, 0 recalculates it on every reference speed change
+//! \param[in] handle         The ESMO controller handle
+//! \param[in] offsetHyst_Hz  The reference speed band, Hz
+static inline void ESMO_setOffsetHyst(ESMO_Handle handle,
+                                      const float32_t offsetHyst_Hz)
+{
+    ESMO_Obj *obj = (ESMO_Obj *)handle;
+
+    obj->offsetHyst = offsetHyst_Hz * obj->speed_sf;
+
+    return;
+}
+
+//! \brief     Enables the angle offset table for the ESMO controller
+//!            With the table, ESMO_run() does not call an arc tangent
+//! \param[in] handle      The ESMO controller handle
+//! \param[in] flag        The enable flag
+static inline void ESMO_setFlag_enableOffsetTable(ESMO_Handle handle,
+                                                  const bool flag)
+{
+    ESMO_Obj *obj = (ESMO_Obj *)handle;
+
+    obj->flagEnableOffsetTable = flag;
+    obj->flagUpdateOffset = true;
+
+    if(flag == true)
+    {
+        ESMO_computeOffsetTable(handle);
+    }
 
     return;
 }
 
+//! \brief     Gets the maximum error of the angle offset table
+//!            The error is computed by ESMO_computeOffsetTableError()
+//! \param[in] handle      The ESMO controller handle
+//! \return    The maximum error against the exact arc tangent, rad
+static inline float32_t ESMO_getOffsetTableError_rad(ESMO_Handle handle)
+{
+    ESMO_Obj *obj = (ESMO_Obj *)handle;
+
+    return(obj->offsetTableErr * MATH_TWO_PI);
+}
+
 //! \brief     Sets speed filter cut off frequency for the ESMO controller
 //! \param[in] handle    The ESMO controller handle
 //! \param[in] filterFc_Hz    The slide filter frequency
@@ -413,6 +506,61 @@ static inline void ESMO_updateKslide(ESMO_Handle handle)
     return;
 }
 
+//! \brief     Gets the PLL angle offset from the angle offset table
+//! \param[in] handle      The ESMO controller handle
+//! \param[in] speedRef    The reference speed (pu)
+//! \return    The angle offset (pu)
+static inline float32_t ESMO_getOffsetTable(ESMO_Handle handle,
+                                            const float32_t speedRef)
+{
+    ESMO_Obj *obj = (ESMO_Obj *)handle;
+
+    float32_t index = MATH_min(MATH_abs(speedRef), 1.0f) *
+                      (float32_t)ESMO_OFFSET_TABLE_SIZE;
+    uint16_t n = (uint16_t)index;
+
+    if(n >= ESMO_OFFSET_TABLE_SIZE)
+    {
+        n = ESMO_OFFSET_TABLE_SIZE - 1;
+    }
+
+    float32_t offset = obj->offsetTable[n] +
+            (index - (float32_t)n) * (obj->offsetTable[n + 1] - obj->offsetTable[n]);
+
+    // the offset is odd in the reference speed
+    return((speedRef < 0.0f) ? -offset : offset);
+}
+
+//! \brief     Updates the PLL angle offset for the ESMO controller
+//!            The offset only depends on the reference speed, the offset
+//!            coefficient and the sliding control filter gain, so it is
+//!            recalculated when one of them changes instead of every period
+//! \param[in] handle      The ESMO controller handle
+static inline void ESMO_updateOffset(ESMO_Handle handle)
+{
+    ESMO_Obj *obj = (ESMO_Obj *)handle;
+
+    if((MATH_abs(obj->speedRef - obj->speedRefOffset) > obj->offsetHyst) ||
+       (obj->flagUpdateOffset == true))
+    {
+        if(obj->flagEnableOffsetTable == true)
+        {
+            obj->thetaOffset = ESMO_getOffsetTable(handle, obj->speedRef);
+        }
+        else
+        {
+            // arc tangent of src radians
+            obj->thetaOffset = __atan2puf32((obj->speedRef * obj->offsetSF),
+                                            obj->Kslf);
+        }
+
+        obj->speedRefOffset = obj->speedRef;
+        obj->flagUpdateOffset = false;
+    }
+
+    return;
+}
+
 //! \brief     Runs the ESMO controller
 //! \param[in] handle      The ESMO controller handle
 //! \param[in] Vdcbus      The dc bus voltage
@@ -458,9 +606,9 @@ static inline void ESMO_run(ESMO_Handle handle,
     obj->Ealpha = obj->Ealpha + obj->Kslf * (obj->Zalpha - obj->Ealpha);
     obj->Ebeta  = obj->Ebeta  + obj->Kslf * (obj->Zbeta  - obj->Ebeta);
 
-    // arc tangent of src radians
-    float32_t thetaOffset = __atan2puf32((obj->speedRef * obj->offsetSF), obj->Kslf);
-    obj->thetaPll  = obj->theta - thetaOffset;
+    // angle offset, only recalculated on a reference speed change
+    ESMO_updateOffset(handle);
+    obj->thetaPll  = obj->theta - obj->thetaOffset;
 
     float32_t pllSine   = __sinpuf32(obj->thetaPll);
     float32_t pllCosine = __cospuf32(obj->thetaPll);
@@ -518,6 +666,164 @@ static inline void ESMO_run(ESMO_Handle handle,
 } // end of ESMO_run() function
 
 
+
+//! \brief Defines the maximum number of observers in an ESMO bank
+//!
+#ifndef ESMO_BANK_NUM_MAX
+#define ESMO_BANK_NUM_MAX       4
+#endif  // ESMO_BANK_NUM_MAX
+
+//! \brief Defines the ESMO bank object
+//!
+//! The bank runs up to ESMO_BANK_NUM_MAX observers per call, e.g. one per
+//! axis of a multi-axis drive, or many observer configurations against the
+//! same recorded trace when tuning Kslide and the filter cut off frequencies
+//! on host. Each variable is an array over the observers, so every stage of
+//! ESMO_run() is one loop over the observers. An observer is configured
+//! with an ESMO object and copied into the bank by ESMO_BANK_setObserver().
+//! The bank always uses the arc tangent for the angle offset
+//!
+typedef struct _ESMO_BANK_Obj_
+{
+    float32_t voltage_sf[ESMO_BANK_NUM_MAX];    // voltage PU scale factor
+    float32_t current_sf[ESMO_BANK_NUM_MAX];    // current PU scale factor
+    float32_t scaleFreq_Hz[ESMO_BANK_NUM_MAX];  // speed PU base frequency
+
+    float32_t Fdsmopos[ESMO_BANK_NUM_MAX];      // motor dependent plant matrix
+    float32_t Fqsmopos[ESMO_BANK_NUM_MAX];      // motor dependent plant matrix
+    float32_t Gdsmopos[ESMO_BANK_NUM_MAX];      // motor dependent control gain
+    float32_t Gqsmopos[ESMO_BANK_NUM_MAX];      // motor dependent control gain
+    float32_t Kslf[ESMO_BANK_NUM_MAX];          // sliding control filter gain
+    float32_t E0[ESMO_BANK_NUM_MAX];            // estimated bemf threshold
+    float32_t Kslide[ESMO_BANK_NUM_MAX];        // sliding control gain
+
+    float32_t EstIalpha[ESMO_BANK_NUM_MAX];     // estimated alfa-axis current
+    float32_t EstIbeta[ESMO_BANK_NUM_MAX];      // estimated beta-axis current
+    float32_t Ealpha[ESMO_BANK_NUM_MAX];        // alfa-axis back EMF
+    float32_t Ebeta[ESMO_BANK_NUM_MAX];         // beta-axis back EMF
+    float32_t Zalpha[ESMO_BANK_NUM_MAX];        // alfa-axis sliding control
+    float32_t Zbeta[ESMO_BANK_NUM_MAX];         // beta-axis sliding control
+
+    float32_t speedRef[ESMO_BANK_NUM_MAX];      // reference speed (pu)
+    float32_t offsetSF[ESMO_BANK_NUM_MAX];      // angle offset scale factor
+    float32_t thetaOffset[ESMO_BANK_NUM_MAX];   // PLL angle offset (pu)
+    float32_t speedRefOffset[ESMO_BANK_NUM_MAX]; // reference speed of the offset
+    float32_t offsetHyst[ESMO_BANK_NUM_MAX];    // reference speed band of the offset
+    bool flagUpdateOffset[ESMO_BANK_NUM_MAX];   // forces an offset update
+    float32_t thetaErrSF[ESMO_BANK_NUM_MAX];    // angle error scale factor
+    float32_t thetaDelta[ESMO_BANK_NUM_MAX];    // angle integration factor
+    float32_t theta[ESMO_BANK_NUM_MAX];         // PLL angle (pu)
+    float32_t thetaEst[ESMO_BANK_NUM_MAX];      // PLL angle (rad)
+
+    float32_t pll_ui[ESMO_BANK_NUM_MAX];        // integral term
+    float32_t pll_Out[ESMO_BANK_NUM_MAX];       // controller output
+    float32_t pll_Kp[ESMO_BANK_NUM_MAX];        // proportional gain
+    float32_t pll_Ki[ESMO_BANK_NUM_MAX];        // integral gain
+    float32_t pll_Umax[ESMO_BANK_NUM_MAX];      // upper saturation limit
+    float32_t pll_Umin[ESMO_BANK_NUM_MAX];      // lower saturation limit
+
+    float32_t speedEst[ESMO_BANK_NUM_MAX];      // estimated speed (pu)
+    float32_t speedFlt[ESMO_BANK_NUM_MAX];      // filtered speed (pu)
+    float32_t lpf_b0[ESMO_BANK_NUM_MAX];        // Low Pass Filter Param b0
+    float32_t lpf_a1[ESMO_BANK_NUM_MAX];        // Low Pass Filter Param a1
+
+    uint16_t numObservers;                      // number of observers in use
+} ESMO_BANK_Obj;
+
+
+//! \brief Defines the ESMO bank handle
+//!
+typedef struct _ESMO_BANK_Obj_ *ESMO_BANK_Handle;
+
+
+//! \brief     Initializes the ESMO bank with no observers to run
+//! \param[in] pMemory   A pointer to the memory for the ESMO bank object
+//! \param[in] numBytes  The number of bytes allocated for the ESMO bank object, bytes
+//! \return The ESMO bank object handle
+extern ESMO_BANK_Handle ESMO_BANK_init(void *pMemory, const size_t numBytes);
+
+
+//! \brief     Sets the number of observers run by the ESMO bank
+//! \param[in] handle        The ESMO bank handle
+//! \param[in] numObservers  The number of observers, up to ESMO_BANK_NUM_MAX
+extern void ESMO_BANK_setNumObservers(ESMO_BANK_Handle handle,
+                                      const uint16_t numObservers);
+
+
+//! \brief     Copies the parameters and the state of an ESMO object into an
+//!            observer of the bank
+//! \param[in] handle      The ESMO bank handle
+//! \param[in] index       The observer index, an index from ESMO_BANK_NUM_MAX
+//!                        on is ignored
+//! \param[in] esmoHandle  The ESMO controller handle
+extern void ESMO_BANK_setObserver(ESMO_BANK_Handle handle, const uint16_t index,
+                                  ESMO_Handle esmoHandle);
+
+
+//! \brief     Copies the state of an observer of the bank back into an ESMO
+//!            object
+//! \param[in] handle      The ESMO bank handle
+//! \param[in] index       The observer index, an index from the number of
+//!                        observers on is ignored and leaves the ESMO object
+//! \param[in] esmoHandle  The ESMO controller handle
+extern void ESMO_BANK_getObserver(ESMO_BANK_Handle handle, const uint16_t index,
+                                  ESMO_Handle esmoHandle);
+
+
+//! \brief     Runs all the observers of the ESMO bank, the same as ESMO_run()
+//!            for each observer
+//! \param[in] handle       The ESMO bank handle
+//! \param[in] pVdcbus      The pointer to the dc bus voltages
+//! \param[in] pVabc_pu     The pointer to the phase voltage values (PU)
+//! \param[in] pIabVec      The pointer to the phase current values
+//! \param[in] inputStride  0: all the observers run on the first input,
+//!                         1: each observer runs on its own input
+extern void ESMO_BANK_run(ESMO_BANK_Handle handle, const float32_t *pVdcbus,
+                          const MATH_vec3 *pVabc_pu, const MATH_vec2 *pIabVec,
+                          const uint16_t inputStride);
+
+
+//! \brief     Gets the PLL angle of an observer of the ESMO bank
+//! \param[in] handle  The ESMO bank handle
+//! \param[in] index   The observer index
+//! \return    The angle from eSMO PLL
+static inline float32_t ESMO_BANK_getAnglePLL(ESMO_BANK_Handle handle,
+                                              const uint16_t index)
+{
+    ESMO_BANK_Obj *obj = (ESMO_BANK_Obj *)handle;
+
+    return(obj->thetaEst[index]);
+}
+
+
+//! \brief     Gets the PLL speed of an observer of the ESMO bank
+//! \param[in] handle  The ESMO bank handle
+//! \param[in] index   The observer index
+//! \return    The speed from eSMO PLL (Hz)
+static inline float32_t ESMO_BANK_getSpeedPLL_Hz(ESMO_BANK_Handle handle,
+                                                 const uint16_t index)
+{
+    ESMO_BANK_Obj *obj = (ESMO_BANK_Obj *)handle;
+
+    return(obj->speedFlt[index] * obj->scaleFreq_Hz[index]);
+}
+
+
+//! \brief     Sets the reference speed of an observer of the ESMO bank
+//! \param[in] handle       The ESMO bank handle
+//! \param[in] index        The observer index
+//! \param[in] speedRef_pu  The reference speed value (PU)
+static inline void ESMO_BANK_setSpeedRef(ESMO_BANK_Handle handle,
+                                         const uint16_t index,
+                                         const float32_t speedRef_pu)
+{
+    ESMO_BANK_Obj *obj = (ESMO_BANK_Obj *)handle;
+
+    obj->speedRef[index] = speedRef_pu;
+
+    return;
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -86,6 +86,8 @@ void ESMO_resetParams(ESMO_Handle handle)
 	obj->Kslide = obj->KslideMin;
 	obj->pll_Kp = obj->pll_KpMin;
 
+	obj->flagUpdateOffset = true;
+
     return;
 }
 
@@ -140,6 +142,12 @@ void ESMO_setParams(ESMO_Handle handle, const USER_Params *pUserParams)
     obj->thetaErrSF = MATH_ONE_OVER_TWO_PI;
 
     obj->offsetDelta = 0.005f;       // rad
+    obj->offsetHyst = 0.0f;          // update the offset on every change
+    obj->speedRefOffset = 0.0f;
+    obj->flagUpdateOffset = true;
+    obj->flagEnableOffsetTable = false;
+    obj->flagOffsetTableValid = false;
+    obj->offsetTableErr = 0.0f;
 
     obj->Kslide = obj->KslideMin;
 
@@ -177,6 +185,8 @@ void ESMO_updateFilterParams(ESMO_Handle handle)
 {
     ESMO_Obj *obj = (ESMO_Obj *)handle;
 
+    float32_t Kslf;
+
     // TempVarLpf = Fc *2 * PI * Ts
     float32_t tempVarLpf = obj->lpfFc_Hz * MATH_TWO_PI * obj->Ts;
 
@@ -187,7 +197,76 @@ void ESMO_updateFilterParams(ESMO_Handle handle)
     obj->lpf_b0 = 1.0f - obj->lpf_a1;
 
     //
-    obj->Kslf = obj->filterFc_sf * MATH_TWO_PI * obj->base_wTs;
+    Kslf = obj->filterFc_sf * MATH_TWO_PI * obj->base_wTs;
+
+    // the angle offset depends on Kslf
+    if(obj->Kslf != Kslf)
+    {
+        obj->Kslf = Kslf;
+        obj->flagUpdateOffset = true;
+    }
+
+    if(obj->flagEnableOffsetTable == true)
+    {
+        ESMO_computeOffsetTable(handle);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+void ESMO_computeOffsetTable(ESMO_Handle handle)
+{
+    ESMO_Obj *obj = (ESMO_Obj *)handle;
+    float32_t speedStep = 1.0f / (float32_t)ESMO_OFFSET_TABLE_SIZE;
+    uint16_t n;
+
+    // the table is still valid for the present coefficients
+    if((obj->flagOffsetTableValid == true) &&
+       (obj->offsetTableSF == obj->offsetSF) &&
+       (obj->offsetTableKslf == obj->Kslf))
+    {
+        return;
+    }
+
+    for(n = 0; n <= ESMO_OFFSET_TABLE_SIZE; n++)
+    {
+        obj->offsetTable[n] = atan2f(((float32_t)n * speedStep * obj->offsetSF),
+                                     obj->Kslf) * MATH_ONE_OVER_TWO_PI;
+    }
+
+    obj->offsetTableSF = obj->offsetSF;
+    obj->offsetTableKslf = obj->Kslf;
+    obj->flagOffsetTableValid = true;
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+void ESMO_computeOffsetTableError(ESMO_Handle handle)
+{
+    ESMO_Obj *obj = (ESMO_Obj *)handle;
+    float32_t speedStep = 1.0f / (float32_t)ESMO_OFFSET_TABLE_SIZE;
+    float32_t offsetErr = 0.0f;
+    uint16_t n, m;
+
+    ESMO_computeOffsetTable(handle);
+
+    // compare the interpolation against the arc tangent inside each segment
+    for(n = 0; n < ESMO_OFFSET_TABLE_SIZE; n++)
+    {
+        for(m = 1; m < 4; m++)
+        {
+            float32_t speed = ((float32_t)n + (float32_t)m * 0.25f) * speedStep;
+            float32_t offset = atan2f((speed * obj->offsetSF), obj->Kslf) *
+                               MATH_ONE_OVER_TWO_PI;
+
+            offsetErr = MATH_max(offsetErr,
+                        MATH_abs(ESMO_getOffsetTable(handle, speed) - offset));
+        }
+    }
+
+    obj->offsetTableErr = offsetErr;
 
     return;
 }
@@ -260,9 +339,9 @@ void ESMO_full_run(ESMO_Handle handle,
         obj->thetaElec_rad += MATH_TWO_PI;
     }
 
-    // arc tangent of src radians
-    float32_t thetaOffset = __atan2puf32((obj->speedRef * obj->offsetSF), obj->Kslf);
-    obj->thetaPll  = obj->theta - thetaOffset;
+    // angle offset, only recalculated on a reference speed change
+    ESMO_updateOffset(handle);
+    obj->thetaPll  = obj->theta - obj->thetaOffset;
 
     float32_t pllSine   = __sinpuf32(obj->thetaPll);
     float32_t pllCosine = __cospuf32(obj->thetaPll);
@@ -318,6 +397,242 @@ void ESMO_full_run(ESMO_Handle handle,
 
     return;
 } // end of ESMO_run() function
+
+//------------------------------------------------------------------------------
+ESMO_BANK_Handle ESMO_BANK_init(void *pMemory, const size_t numBytes)
+{
+    ESMO_BANK_Handle handle;
+
+    if(numBytes < sizeof(ESMO_BANK_Obj))
+    {
+        return((ESMO_BANK_Handle)NULL);
+    }
+
+    // assign the handle
+    handle = (ESMO_BANK_Handle)pMemory;
+
+    // no observer runs until ESMO_BANK_setNumObservers() is called
+    ((ESMO_BANK_Obj *)handle)->numObservers = 0;
+
+    return(handle);
+}   // end of ESMO_BANK_init() function
+
+//------------------------------------------------------------------------------
+void ESMO_BANK_setNumObservers(ESMO_BANK_Handle handle,
+                               const uint16_t numObservers)
+{
+    ESMO_BANK_Obj *obj = (ESMO_BANK_Obj *)handle;
+
+    obj->numObservers = (numObservers > ESMO_BANK_NUM_MAX) ?
+                        ESMO_BANK_NUM_MAX : numObservers;
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+void ESMO_BANK_setObserver(ESMO_BANK_Handle handle, const uint16_t index,
+                           ESMO_Handle esmoHandle)
+{
+    ESMO_BANK_Obj *obj = (ESMO_BANK_Obj *)handle;
+    ESMO_Obj *esmo = (ESMO_Obj *)esmoHandle;
+
+    // the index is outside of the bank
+    if(index >= ESMO_BANK_NUM_MAX)
+    {
+        return;
+    }
+
+    obj->voltage_sf[index] = esmo->voltage_sf;
+    obj->current_sf[index] = esmo->current_sf;
+    obj->scaleFreq_Hz[index] = esmo->scaleFreq_Hz;
+
+    obj->Fdsmopos[index] = esmo->Fdsmopos;
+    obj->Fqsmopos[index] = esmo->Fqsmopos;
+    obj->Gdsmopos[index] = esmo->Gdsmopos;
+    obj->Gqsmopos[index] = esmo->Gqsmopos;
+    obj->Kslf[index] = esmo->Kslf;
+    obj->E0[index] = esmo->E0;
+    obj->Kslide[index] = esmo->Kslide;
+
+    obj->speedRef[index] = esmo->speedRef;
+    obj->offsetSF[index] = esmo->offsetSF;
+    obj->thetaOffset[index] = esmo->thetaOffset;
+    obj->speedRefOffset[index] = esmo->speedRefOffset;
+    obj->offsetHyst[index] = esmo->offsetHyst;
+    obj->flagUpdateOffset[index] = esmo->flagUpdateOffset;
+    obj->thetaErrSF[index] = esmo->thetaErrSF;
+    obj->thetaDelta[index] = esmo->thetaDelta;
+
+    obj->pll_Kp[index] = esmo->pll_Kp;
+    obj->pll_Ki[index] = esmo->pll_Ki;
+    obj->pll_Umax[index] = esmo->pll_Umax;
+    obj->pll_Umin[index] = esmo->pll_Umin;
+
+    obj->lpf_b0[index] = esmo->lpf_b0;
+    obj->lpf_a1[index] = esmo->lpf_a1;
+
+    obj->EstIalpha[index] = esmo->EstIalpha;
+    obj->EstIbeta[index] = esmo->EstIbeta;
+    obj->Ealpha[index] = esmo->Ealpha;
+    obj->Ebeta[index] = esmo->Ebeta;
+    obj->Zalpha[index] = esmo->Zalpha;
+    obj->Zbeta[index] = esmo->Zbeta;
+
+    obj->theta[index] = esmo->theta;
+    obj->thetaEst[index] = esmo->thetaEst;
+    obj->pll_ui[index] = esmo->pll_ui;
+    obj->pll_Out[index] = esmo->pll_Out;
+    obj->speedEst[index] = esmo->speedEst;
+    obj->speedFlt[index] = esmo->speedFlt;
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+void ESMO_BANK_getObserver(ESMO_BANK_Handle handle, const uint16_t index,
+                           ESMO_Handle esmoHandle)
+{
+    ESMO_BANK_Obj *obj = (ESMO_BANK_Obj *)handle;
+    ESMO_Obj *esmo = (ESMO_Obj *)esmoHandle;
+
+    // the index is not one of the running observers
+    if(index >= obj->numObservers)
+    {
+        return;
+    }
+
+    esmo->EstIalpha = obj->EstIalpha[index];
+    esmo->EstIbeta = obj->EstIbeta[index];
+    esmo->Ealpha = obj->Ealpha[index];
+    esmo->Ebeta = obj->Ebeta[index];
+    esmo->Zalpha = obj->Zalpha[index];
+    esmo->Zbeta = obj->Zbeta[index];
+
+    esmo->thetaOffset = obj->thetaOffset[index];
+    esmo->speedRefOffset = obj->speedRefOffset[index];
+    esmo->flagUpdateOffset = obj->flagUpdateOffset[index];
+
+    esmo->theta = obj->theta[index];
+    esmo->thetaEst = obj->thetaEst[index];
+    esmo->pll_ui = obj->pll_ui[index];
+    esmo->pll_Out = obj->pll_Out[index];
+    esmo->speedEst = obj->speedEst[index];
+    esmo->speedFlt = obj->speedFlt[index];
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+void ESMO_BANK_run(ESMO_BANK_Handle handle, const float32_t *pVdcbus,
+                   const MATH_vec3 *pVabc_pu, const MATH_vec2 *pIabVec,
+                   const uint16_t inputStride)
+{
+    ESMO_BANK_Obj *obj = (ESMO_BANK_Obj *)handle;
+    uint16_t num = obj->numObservers;
+    uint16_t n, in;
+
+    // Voltages, sliding mode current observer and back EMF
+    for(n = 0, in = 0; n < num; n++, in += inputStride)
+    {
+        float32_t Vtemp = pVdcbus[in] * obj->voltage_sf[n];
+
+        float32_t VphaseA = Vtemp * (pVabc_pu[in].value[0] * 2.0f -
+                            pVabc_pu[in].value[1] - pVabc_pu[in].value[2]);
+
+        float32_t VphaseB = Vtemp * (pVabc_pu[in].value[1] * 2.0f -
+                            pVabc_pu[in].value[0] - pVabc_pu[in].value[2]);
+
+        float32_t Valpha = VphaseA;
+        float32_t Vbeta = (VphaseA + VphaseB * 2.0f) * MATH_ONE_OVER_SQRT_THREE;
+
+        float32_t ValphaError = Valpha - obj->Ealpha[n] - obj->Zalpha[n];
+        float32_t VbetaError  = Vbeta - obj->Ebeta[n] - obj->Zbeta[n];
+
+        obj->EstIalpha[n] = obj->Gdsmopos[n] * ValphaError +
+                            obj->Fdsmopos[n] * obj->EstIalpha[n];
+        obj->EstIbeta[n]  = obj->Gqsmopos[n] * VbetaError +
+                            obj->Fqsmopos[n] * obj->EstIbeta[n];
+
+        float32_t IalphaError = obj->EstIalpha[n] -
+                                pIabVec[in].value[0] * obj->current_sf[n];
+        float32_t IbetaError  = obj->EstIbeta[n] -
+                                pIabVec[in].value[1] * obj->current_sf[n];
+
+        obj->Zalpha[n] = __fsat(IalphaError, obj->E0[n], -obj->E0[n]) *
+                         obj->Kslide[n];
+        obj->Zbeta[n]  = __fsat(IbetaError,  obj->E0[n], -obj->E0[n]) *
+                         obj->Kslide[n];
+
+        obj->Ealpha[n] = obj->Ealpha[n] +
+                         obj->Kslf[n] * (obj->Zalpha[n] - obj->Ealpha[n]);
+        obj->Ebeta[n]  = obj->Ebeta[n] +
+                         obj->Kslf[n] * (obj->Zbeta[n] - obj->Ebeta[n]);
+    }
+
+    // Angle offsets, only recalculated on a reference speed change
+    for(n = 0; n < num; n++)
+    {
+        if((MATH_abs(obj->speedRef[n] - obj->speedRefOffset[n]) >
+            obj->offsetHyst[n]) || (obj->flagUpdateOffset[n] == true))
+        {
+            obj->thetaOffset[n] = __atan2puf32((obj->speedRef[n] * obj->offsetSF[n]),
+                                               obj->Kslf[n]);
+            obj->speedRefOffset[n] = obj->speedRef[n];
+            obj->flagUpdateOffset[n] = false;
+        }
+    }
+
+    // PLL on the back EMF
+    for(n = 0; n < num; n++)
+    {
+        float32_t thetaPll = obj->theta[n] - obj->thetaOffset[n];
+
+        float32_t pllSine   = __sinpuf32(thetaPll);
+        float32_t pllCosine = __cospuf32(thetaPll);
+
+        float32_t Ed = obj->Ealpha[n] * pllCosine + obj->Ebeta[n] * pllSine;
+        float32_t Eq = obj->Ebeta[n] * pllCosine - obj->Ealpha[n] * pllSine;
+        float32_t Eq_mag = sqrtf(obj->Ealpha[n] * obj->Ealpha[n] +
+                                 obj->Ebeta[n] * obj->Ebeta[n]);
+
+        float32_t thetaErrSF = (Eq >= 0.0f) ? -obj->thetaErrSF[n] :
+                                              obj->thetaErrSF[n];
+
+        float32_t thetaErr = Ed * thetaErrSF / Eq_mag;
+
+        obj->pll_ui[n] = (obj->pll_Ki[n] * thetaErr) + obj->pll_ui[n];
+
+        obj->pll_Out[n] = __fsat((obj->pll_Kp[n] * thetaErr + obj->pll_ui[n]),
+                                 obj->pll_Umax[n], obj->pll_Umin[n]);
+    }
+
+    // Speed filter and angle integration
+    for(n = 0; n < num; n++)
+    {
+        float32_t theta;
+        float32_t thetaEst;
+
+        obj->speedEst[n] = (obj->pll_Out[n] + obj->speedEst[n]) * 0.5f;
+
+        obj->speedFlt[n] = obj->lpf_b0[n] * obj->pll_Out[n] +
+                           obj->lpf_a1[n] * obj->speedFlt[n];
+
+        theta = obj->theta[n] + obj->speedFlt[n] * obj->thetaDelta[n];
+
+        theta = (theta > 1.0f) ? (theta - 1.0f) :
+                ((theta < -1.0f) ? (theta + 1.0f) : theta);
+
+        thetaEst = theta * MATH_TWO_PI;
+
+        thetaEst = (thetaEst > MATH_PI) ? (thetaEst - MATH_TWO_PI) :
+                   ((thetaEst < (-MATH_PI)) ? (thetaEst + MATH_TWO_PI) : thetaEst);
+
+        obj->theta[n] = theta;
+        obj->thetaEst[n] = thetaEst;
+    }
+
+    return;
+} // end of ESMO_BANK_run() function
 //----------------------------------------------------------------
 
 // end of file
@@ -0,0 +1,181 @@
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+#ifndef EST_TLM_H
+#define EST_TLM_H
+
+//! \file   libraries\observers\est_tlm\include\est_tlm.h
+//! \brief  Contains the public interface to the estimator telemetry
+//!         snapshot (EST_TLM), one call fills the telemetry of the
+//!         background loop
+//!
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! \defgroup EST_TLM EST_TLM
+//! @{
+//
+//*****************************************************************************
+
+// the includes
+#include "libraries/math/include/math.h"
+
+//modules
+#include "est.h"
+
+// **************************************************************************
+// the typedefs
+
+//! \brief Defines the estimator telemetry snapshot
+//!
+typedef struct _EST_TLM_Data_
+{
+    // fast group, refreshed on every snapshot
+    float32_t   angle_rad;          // estimated angle, rad
+    float32_t   fm_Hz;              // mechanical frequency, Hz
+    float32_t   fmLp_Hz;            // filtered mechanical frequency, Hz
+    float32_t   fe_Hz;              // electrical frequency, Hz
+    float32_t   fslip_Hz;           // slip frequency, Hz
+    float32_t   speed_rpm;          // speed, rpm
+    float32_t   speedRef_Hz;        // trajectory speed reference, Hz
+    float32_t   accel_rps2;         // acceleration, rad/s^2
+    float32_t   dcBus_V;            // dc bus voltage, V
+    float32_t   torque_Nm;          // computed torque, N.m
+    MATH_Vec2   Idq_A;              // dq currents, A
+    MATH_Vec2   Idq_ref_A;          // dq current references, A
+    MATH_Vec2   Vdq_V;              // dq voltages, V
+    MATH_Vec2   Edq_V;              // dq back emf, V
+
+    EST_State_e       state;        // estimator state
+    EST_Traj_State_e  trajState;    // trajectory state
+    EST_ErrorCode_e   errorCode;    // estimator error code
+
+    // slow group, refreshed every decimSlow snapshots
+    float32_t   flux_Wb;            // rotor flux, Wb
+    float32_t   Rs_Ohm;             // stator resistance, Ohm
+    float32_t   RsOnLine_Ohm;       // online stator resistance, Ohm
+    float32_t   Ls_d_H;             // d axis inductance, H
+    float32_t   Ls_q_H;             // q axis inductance, H
+#if !defined(_PMSM_FAST_LIB)
+    float32_t   Rr_Ohm;             // rotor resistance, Ohm
+#endif  // !_PMSM_FAST_LIB
+
+    uint32_t    sequence;           // snapshot count, changes on every fill
+
+    bool        flagMotorIdentified;    // motor identified flag
+    bool        flagForceAngle;         // force angle active flag
+} EST_TLM_Data;
+
+//! \brief Defines the estimator telemetry (EST_TLM) object
+//!
+typedef struct _EST_TLM_Obj_
+{
+    EST_TLM_Data  data;             // the latest snapshot
+    EST_Handle    estHandle;        // the estimator to read
+    uint16_t      decimFast;        // calls per snapshot, 1 = every call
+    uint16_t      decimSlow;        // snapshots per slow group refresh
+    uint16_t      countFast;        // call counter
+    uint16_t      countSlow;        // snapshot counter
+} EST_TLM_Obj;
+
+//! \brief Defines the EST_TLM handle
+//!
+typedef struct _EST_TLM_Obj_ *EST_TLM_Handle;
+
+// **************************************************************************
+// the function prototypes
+
+//! \brief     Initializes the estimator telemetry (EST_TLM) object
+//! \param[in] pMemory   A pointer to the memory for the EST_TLM object
+//! \param[in] numBytes  The number of bytes allocated for the EST_TLM object
+//! \return    The EST_TLM handle
+extern EST_TLM_Handle EST_TLM_init(void *pMemory, const size_t numBytes);
+
+//! \brief     Sets the estimator and the decimation of the snapshots
+//! \param[in] handle     The EST_TLM handle
+//! \param[in] estHandle  The estimator handle
+//! \param[in] decimFast  The calls of EST_TLM_run() per snapshot, >= 1
+//! \param[in] decimSlow  The snapshots per refresh of the slowly changing
+//!                       motor parameters, >= 1
+extern void EST_TLM_setParams(EST_TLM_Handle handle, EST_Handle estHandle,
+                              const uint16_t decimFast, const uint16_t decimSlow);
+
+//! \brief     Fills the whole snapshot now, the decimation restarts
+//! \param[in] handle     The EST_TLM handle
+extern void EST_TLM_update(EST_TLM_Handle handle);
+
+//! \brief     Runs the telemetry from the background loop, fills the fast
+//!            group every decimFast calls and the slow group every
+//!            decimSlow snapshots
+//! \param[in] handle     The EST_TLM handle
+//! \return    true when the snapshot was refreshed in this call
+extern bool EST_TLM_run(EST_TLM_Handle handle);
+
+//! \brief     Gets the latest snapshot
+//! \param[in] handle     The EST_TLM handle
+//! \return    The pointer to the snapshot
+static inline const EST_TLM_Data *EST_TLM_getData(EST_TLM_Handle handle)
+{
+    EST_TLM_Obj *obj = (EST_TLM_Obj *)handle;
+
+    return(&obj->data);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif //end of EST_TLM_H definition
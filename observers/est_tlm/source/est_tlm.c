@@ -0,0 +1,184 @@
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+
+//! \file   libraries\observers\est_tlm\source\est_tlm.c
+//! \brief  Portable C floating point code.  These functions define the
+//!         estimator telemetry snapshot (EST_TLM)
+//!
+
+#include "est_tlm.h"
+
+// **************************************************************************
+// the defines
+
+// **************************************************************************
+// the globals
+
+
+// **************************************************************************
+// the functions
+
+//------------------------------------------------------------------------------
+//! \brief     Reads the fast group of the snapshot from the estimator
+static void EST_TLM_updateFast(EST_TLM_Obj *obj)
+{
+    EST_Handle estHandle = obj->estHandle;
+    EST_TLM_Data *pData = &obj->data;
+
+    pData->angle_rad = EST_getAngle_rad(estHandle);
+    pData->fm_Hz = EST_getFm_Hz(estHandle);
+    pData->fmLp_Hz = EST_getFm_lp_Hz(estHandle);
+    pData->fe_Hz = EST_getFe_Hz(estHandle);
+    pData->fslip_Hz = EST_getFslip_Hz(estHandle);
+    pData->speed_rpm = EST_getSpeed_rpm(estHandle);
+    pData->speedRef_Hz = EST_getSpeed_ref_Hz(estHandle);
+    pData->accel_rps2 = EST_getAccel_rps2(estHandle);
+    pData->dcBus_V = EST_getDcBus_V(estHandle);
+    pData->torque_Nm = EST_computeTorque_Nm(estHandle);
+
+    EST_getIdq_A(estHandle, &pData->Idq_A);
+    EST_getIdq_ref_A(estHandle, &pData->Idq_ref_A);
+    EST_getVdq_V(estHandle, &pData->Vdq_V);
+    EST_getEdq_V(estHandle, &pData->Edq_V);
+
+    pData->state = EST_getState(estHandle);
+    pData->trajState = EST_getTrajState(estHandle);
+    pData->errorCode = EST_getErrorCode(estHandle);
+
+    pData->flagMotorIdentified = EST_getFlag_motorIdentified(estHandle);
+    pData->flagForceAngle = EST_getForceAngleStatus(estHandle);
+
+    pData->sequence++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+//! \brief     Reads the slow group of the snapshot from the estimator
+static void EST_TLM_updateSlow(EST_TLM_Obj *obj)
+{
+    EST_Handle estHandle = obj->estHandle;
+    EST_TLM_Data *pData = &obj->data;
+
+    pData->flux_Wb = EST_getFlux_Wb(estHandle);
+    pData->Rs_Ohm = EST_getRs_Ohm(estHandle);
+    pData->RsOnLine_Ohm = EST_getRsOnLine_Ohm(estHandle);
+    pData->Ls_d_H = EST_getLs_d_H(estHandle);
+    pData->Ls_q_H = EST_getLs_q_H(estHandle);
+#if !defined(_PMSM_FAST_LIB)
+    pData->Rr_Ohm = EST_getRr_Ohm(estHandle);
+#endif  // !_PMSM_FAST_LIB
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+EST_TLM_Handle EST_TLM_init(void *pMemory, const size_t numBytes)
+{
+    EST_TLM_Handle handle;
+
+    if(numBytes < sizeof(EST_TLM_Obj))
+    {
+        return((EST_TLM_Handle)NULL);
+    }
+
+    // assign the handle
+    handle = (EST_TLM_Handle)pMemory;
+
+    return(handle);
+} // end of EST_TLM_init() function
+
+//------------------------------------------------------------------------------
+void EST_TLM_setParams(EST_TLM_Handle handle, EST_Handle estHandle,
+                       const uint16_t decimFast, const uint16_t decimSlow)
+{
+    EST_TLM_Obj *obj = (EST_TLM_Obj *)handle;
+
+    obj->estHandle = estHandle;
+    obj->decimFast = (decimFast > 0) ? decimFast : 1;
+    obj->decimSlow = (decimSlow > 0) ? decimSlow : 1;
+
+    obj->data.sequence = 0;
+
+    EST_TLM_update(handle);
+
+    return;
+} // end of EST_TLM_setParams() function
+
+//------------------------------------------------------------------------------
+void EST_TLM_update(EST_TLM_Handle handle)
+{
+    EST_TLM_Obj *obj = (EST_TLM_Obj *)handle;
+
+    EST_TLM_updateFast(obj);
+    EST_TLM_updateSlow(obj);
+
+    obj->countFast = 0;
+    obj->countSlow = 0;
+
+    return;
+} // end of EST_TLM_update() function
+
+//------------------------------------------------------------------------------
+bool EST_TLM_run(EST_TLM_Handle handle)
+{
+    EST_TLM_Obj *obj = (EST_TLM_Obj *)handle;
+
+    obj->countFast++;
+
+    if(obj->countFast < obj->decimFast)
+    {
+        return(false);
+    }
+
+    obj->countFast = 0;
+
+    EST_TLM_updateFast(obj);
+
+    obj->countSlow++;
+
+    if(obj->countSlow >= obj->decimSlow)
+    {
+        obj->countSlow = 0;
+
+        EST_TLM_updateSlow(obj);
+    }
+
+    return(true);
+} // end of EST_TLM_run() function
+
+
+//----------------------------------------------------------------
+
+// end of file
@@ -73,6 +73,10 @@ extern "C"
 // **************************************************************************
 // the defines
 
+//! \brief Defines the number of hall edges in one electrical revolution
+//!
+#define HALL_EDGE_NUM           6
+
 
 // **************************************************************************
 // the typedefs
@@ -88,6 +92,31 @@ typedef enum
 
 #ifdef HALL_CAL
 #define CAL_BUF_NUM         13
+
+//! \brief Defines the number of queued calibration edges, power of 2
+//!
+#define HALL_CAL_QUEUE_NUM  8
+
+//! \brief Defines a calibration edge captured in the ISR
+//!
+typedef struct _HALL_CalEdge_
+{
+    float32_t angle_rad;            // reference angle at the edge
+    float32_t speed_Hz;             // reference speed at the edge
+    uint16_t  hallIndex;            // hall index entered at the edge
+} HALL_CalEdge;
+
+//! \brief Defines the least-squares sums of a hall edge
+//!
+typedef struct _HALL_CalSums_
+{
+    float32_t num;                  // number of edges
+    float32_t sumX;                 // sum of speed deviations, Hz
+    float32_t sumY;                 // sum of angle deviations, rad
+    float32_t sumXX;                //
+    float32_t sumXY;                //
+    float32_t sumYY;                //
+} HALL_CalSums;
 #endif  //HALL_CAL
 
 
@@ -119,6 +148,22 @@ typedef struct _HALL_Obj_
     uint16_t  hallDirection;        //
     HALL_Status_e hallStatus;       //
 
+    uint32_t  edgeTicks[HALL_EDGE_NUM]; // ticks between the last six edges
+    uint32_t  edgeTicksSum;         // ticks of the last electrical revolution
+    uint32_t  edgeTickCount;        // ticks since the last edge
+    float32_t omegaRev_rad[HALL_EDGE_NUM];  // revolution average speeds, rad/tick
+    float32_t thetaEdge_rad;        // angle of the last edge
+    float32_t thetaStep_rad;        // angle increment of the next tick
+    float32_t thetaAccel_rad;       // change of the angle increment per tick
+    float32_t thetaTravel_rad;      // angle travelled since the last edge
+    float32_t thetaInterp_rad;      // interpolated angle
+    float32_t speedInterp_Hz;       // speed at the interpolated angle, Hz
+    float32_t tickScaler;           // converts rad/tick to Hz
+    uint16_t  edgeIndex;            // ring buffer index of the next edge
+    uint16_t  edgeNum;              // number of valid edge intervals
+    uint16_t  interpIndexPrev;      // hall index of the last edge
+    bool      flagEdgeStart;        // the first edge has been seen
+
 #ifdef HALL_CAL
     float32_t thetaCalBuff[7];               //
     float32_t thetaIndexBuff[CAL_BUF_NUM];   //
@@ -126,6 +171,19 @@ typedef struct _HALL_Obj_
     uint16_t  hallIndexPre;                  //
     uint16_t  hallIndexBuf[CAL_BUF_NUM];     //
     uint16_t  hallIndexFlag;                 //
+
+    HALL_CalEdge calQueue[HALL_CAL_QUEUE_NUM];  // edges from the ISR
+    HALL_CalSums calSums[7];                 // 1~6 are valid value
+    float32_t calAngleNom_rad[7];            // first reference angle per edge
+    float32_t calSpeedNom_Hz;                // first reference speed
+    float32_t calDelay_radpHz;               // fitted sensor delay, rad/Hz
+    float32_t calStdError_rad;               // standard error of the edges
+    uint16_t  calHead;                       // written by the ISR
+    uint16_t  calTail;                       // read by the background task
+    uint16_t  calIndexPrev;                  //
+    uint16_t  calNumEdges;                   // number of fitted edges
+    uint16_t  calNumOverrun;                 // edges dropped on a full queue
+    bool      flagCalSpeedNom;               // calSpeedNom_Hz is set
 #endif  //HALL_CAL
 } HALL_Obj;
 
@@ -171,6 +229,38 @@ static inline float32_t HALL_getAngle_rad(HALL_Handle handle)
 }
 
 
+//! \brief     Gets the interpolated angle from the hall estimator, rad
+//! \param[in] handle  the HALL Handle
+static inline float32_t HALL_getAngleInterp_rad(HALL_Handle handle)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    return(obj->thetaInterp_rad);
+}
+
+//! \brief     Gets the speed at the interpolated angle, Hz
+//! \param[in] handle  the HALL Handle
+static inline float32_t HALL_getSpeedInterp_Hz(HALL_Handle handle)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    return(obj->speedInterp_Hz);
+}
+
+//! \brief     Resets the angle interpolation of the hall estimator
+//! \param[in] handle  the HALL Handle
+extern void HALL_resetInterp(HALL_Handle handle);
+
+//! \brief     Updates the angle interpolation on a hall edge
+//!            The ticks between the last six edges are kept in a ring
+//!            buffer, so the speed is averaged over one electrical
+//!            revolution and does not depend on the placement of the
+//!            sensors. The acceleration is the change of that speed over the
+//!            last revolution. The reciprocals come from MATH_getRecip()
+//! \param[in] handle    the HALL Handle
+//! \param[in] speedRef  The reference speed value
+extern void HALL_runEdge(HALL_Handle handle, const float32_t speedRef);
+
 //! \brief     Gets the hall sensors input GPIO state
 //! \param[in] handle  the HALL Handle
 static inline uint16_t HALL_getInputState(HALL_Handle handle)
@@ -277,6 +367,107 @@ static inline void HALL_calibrateIndexAngle(HALL_Handle handle, float32_t angle)
 
     return;
 }
+
+//! \brief     Captures a hall edge for the least-squares calibration, runs
+//!            in the ISR with a reference angle from an observer or the
+//!            open-loop angle generator, the motor turns in the positive
+//!            direction
+//! \param[in] handle     The HALL controller handle
+//! \param[in] angle_rad  The reference angle, rad
+//! \param[in] speed_Hz   The reference speed, Hz
+static inline void HALL_captureCalEdge(HALL_Handle handle,
+                                       const float32_t angle_rad,
+                                       const float32_t speed_Hz)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+    uint16_t hallIndex = HALL_getInputState(handle);
+
+    if(hallIndex != obj->calIndexPrev)
+    {
+        // only the edges in the positive direction are fitted
+        if(obj->calIndexPrev == obj->hallPrev[hallIndex])
+        {
+            uint16_t head = obj->calHead & (HALL_CAL_QUEUE_NUM - 1);
+
+            // a full queue drops the edge rather than overwrite an edge the
+            // background task has not read yet
+            if((uint16_t)(obj->calHead - obj->calTail) < HALL_CAL_QUEUE_NUM)
+            {
+                obj->calQueue[head].angle_rad = angle_rad;
+                obj->calQueue[head].speed_Hz = speed_Hz;
+                obj->calQueue[head].hallIndex = hallIndex;
+
+                obj->calHead++;
+            }
+            else
+            {
+                obj->calNumOverrun++;
+            }
+        }
+
+        obj->calIndexPrev = hallIndex;
+    }
+
+    return;
+}
+
+//! \brief     Resets the least-squares calibration
+//! \param[in] handle     The HALL controller handle
+extern void HALL_resetCalibration(HALL_Handle handle);
+
+//! \brief     Runs the least-squares calibration in the background task
+//!            Each edge angle is fitted as the reference angle at the edge
+//!            minus a sensor delay common to all the edges times the speed,
+//!            so speed ripple during the calibration does not bias the
+//!            edges. The fitted edge angles at the mean calibration speed are
+//!            written to thetaCalBuff
+//! \param[in] handle     The HALL controller handle
+//! \return    The standard error of the edge angles, rad
+extern float32_t HALL_runCalibration(HALL_Handle handle);
+
+//! \brief     Gets the standard error of the calibrated edge angles
+//! \param[in] handle     The HALL controller handle
+//! \return    The standard error, rad, a negative value until the fit has
+//!            enough edges
+static inline float32_t HALL_getCalStdError_rad(HALL_Handle handle)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    return(obj->calStdError_rad);
+}
+
+//! \brief     Gets the number of calibration edges dropped on a full queue
+//!            Each edge is fitted on its own, so dropped edges only reduce
+//!            the number of fitted edges. A growing count means
+//!            HALL_runCalibration() runs too seldom for the calibration speed
+//! \param[in] handle     The HALL controller handle
+//! \return    The number of dropped edges since the calibration reset
+static inline uint16_t HALL_getCalNumOverrun(HALL_Handle handle)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    return(obj->calNumOverrun);
+}
+
+//! \brief     Gets the fitted sensor delay of the calibration
+//! \param[in] handle     The HALL controller handle
+//! \return    The delay between the edges and the reference angle, s
+static inline float32_t HALL_getCalDelay_sec(HALL_Handle handle)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    return(obj->calDelay_radpHz * MATH_ONE_OVER_TWO_PI);
+}
+
+//! \brief     Gets the calibrated angle buffer
+//! \param[in] handle     The HALL controller handle
+//! \return    The pointer to the edge angles, 1~6 are valid value
+static inline const float32_t *HALL_getCalAngleBuf(HALL_Handle handle)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    return(&obj->thetaCalBuff[0]);
+}
 #endif  //HALL_CAL
 
 //! \brief     Sets the force angle and index for next step of the hall estimator
@@ -399,6 +590,60 @@ static inline void HALL_run(HALL_Handle handle, float32_t speedRef)
     return;
 }
 
+//! \brief     Interpolates the angle of the HALL controller between the edges
+//!            Call after HALL_run(), which reads the hall index. The angle
+//!            moves from the last edge with the speed and acceleration of
+//!            HALL_runEdge(), and stops at the next edge
+//! \param[in] handle  The HALL controller handle
+//! \param[in] speedRef The reference speed value to the controller
+static inline void HALL_runInterp(HALL_Handle handle, float32_t speedRef)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    obj->edgeTickCount++;
+
+    if(obj->hallIndex != obj->interpIndexPrev)
+    {
+        obj->interpIndexPrev = obj->hallIndex;
+
+        HALL_runEdge(handle, speedRef);
+    }
+    else if(obj->edgeTickCount > obj->timeCountMax)
+    {
+        HALL_resetInterp(handle);
+    }
+    else
+    {
+        obj->thetaTravel_rad += obj->thetaStep_rad;
+        obj->thetaStep_rad = MATH_max(obj->thetaStep_rad + obj->thetaAccel_rad,
+                                      0.0f);
+
+        // do not pass the next edge
+        obj->thetaTravel_rad = MATH_min(obj->thetaTravel_rad,
+                                        MATH_PI * MATH_ONE_OVER_THREE);
+    }
+
+    if(speedRef > 0.0f)
+    {
+        obj->thetaInterp_rad = obj->thetaEdge_rad + obj->thetaTravel_rad;
+    }
+    else
+    {
+        obj->thetaInterp_rad = obj->thetaEdge_rad - obj->thetaTravel_rad;
+    }
+
+    if(obj->thetaInterp_rad >= MATH_PI)
+    {
+        obj->thetaInterp_rad = obj->thetaInterp_rad - MATH_TWO_PI;
+    }
+    else if(obj->thetaInterp_rad <= -MATH_PI)
+    {
+        obj->thetaInterp_rad = obj->thetaInterp_rad + MATH_TWO_PI;
+    }
+
+    return;
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
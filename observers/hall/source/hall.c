@@ -89,6 +89,7 @@ void HALL_setParams(HALL_Handle handle, const USER_Params *pUserParams)
     obj->thetaDelta_rad = MATH_TWO_PI / 36.0f;
     obj->timeCountMax = pUserParams->ctrlFreq_Hz / 1.5f;       // 0.25Hz
     obj->speedSwitch_Hz = 50.0f;
+    obj->tickScaler = pUserParams->ctrlFreq_Hz * MATH_ONE_OVER_TWO_PI;
 
     obj->hallPrev[0] = 4;
     obj->hallPrev[1] = 3;
@@ -100,6 +101,8 @@ void HALL_setParams(HALL_Handle handle, const USER_Params *pUserParams)
 
 #ifdef HALL_CAL
     obj->hallIndexFlag = 0;       //
+
+    HALL_resetCalibration(handle);
 #endif  //HALL_CAL
 
     return;
@@ -132,9 +135,280 @@ void HALL_resetParams(HALL_Handle handle)
     obj->hallIndexPrev = 0;
     obj->hallDirection = 0;
 
+    obj->interpIndexPrev = 0;
+    obj->thetaEdge_rad = 0.0f;
+    obj->thetaInterp_rad = 0.0f;
+
+    HALL_resetInterp(handle);
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+void HALL_resetInterp(HALL_Handle handle)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    uint16_t  cnt;
+
+    for(cnt = 0; cnt < HALL_EDGE_NUM; cnt++)
+    {
+        obj->edgeTicks[cnt] = 0;
+        obj->omegaRev_rad[cnt] = 0.0f;
+    }
+
+    obj->edgeTicksSum = 0;
+    obj->edgeTickCount = 0;
+    obj->edgeIndex = 0;
+    obj->edgeNum = 0;
+    obj->flagEdgeStart = false;
+
+    obj->thetaStep_rad = 0.0f;
+    obj->thetaAccel_rad = 0.0f;
+    obj->thetaTravel_rad = 0.0f;
+    obj->speedInterp_Hz = 0.0f;
+
     return;
 }
 
+//------------------------------------------------------------------------------
+void HALL_runEdge(HALL_Handle handle, const float32_t speedRef)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    uint32_t ticks = obj->edgeTickCount;
+    float32_t omega_rad = 0.0f;
+    float32_t accel_rad = 0.0f;
+
+    obj->edgeTickCount = 0;
+
+    if(speedRef > 0.0f)
+    {
+        obj->thetaEdge_rad = obj->thetaBuff[obj->hallIndex] + obj->thetaDelta_rad;
+    }
+    else
+    {
+        obj->thetaEdge_rad = obj->thetaBuff[obj->hallIndex] - obj->thetaDelta_rad;
+    }
+
+    obj->thetaTravel_rad = 0.0f;
+
+    if((obj->flagEdgeStart == true) && (ticks > 0))
+    {
+        uint16_t index = obj->edgeIndex;
+
+        // replace the interval of the same sector one revolution ago
+        obj->edgeTicksSum = obj->edgeTicksSum + ticks - obj->edgeTicks[index];
+        obj->edgeTicks[index] = ticks;
+
+        obj->edgeIndex++;
+
+        if(obj->edgeIndex >= HALL_EDGE_NUM)
+        {
+            obj->edgeIndex = 0;
+        }
+
+        if(obj->edgeNum < HALL_EDGE_NUM)
+        {
+            obj->edgeNum++;
+
+            // a single sector until one revolution is captured
+            omega_rad = MATH_PI * MATH_ONE_OVER_THREE * MATH_getRecip(ticks);
+        }
+        else
+        {
+            float32_t omegaRev_rad = MATH_TWO_PI * MATH_getRecip(obj->edgeTicksSum);
+            float32_t ticksSum = (float32_t)obj->edgeTicksSum;
+
+            // the speed change over one revolution, the tick quantization
+            // of a single interval is too coarse for the acceleration
+            if(obj->omegaRev_rad[index] > 0.0f)
+            {
+                accel_rad = (omegaRev_rad - obj->omegaRev_rad[index]) *
+                            MATH_getRecip(obj->edgeTicksSum);
+            }
+
+            obj->omegaRev_rad[index] = omegaRev_rad;
+
+            // the average speed is centred half a revolution ago
+            omega_rad = omegaRev_rad + accel_rad * 0.5f * ticksSum;
+        }
+    }
+
+    obj->flagEdgeStart = true;
+
+    obj->thetaStep_rad = omega_rad + 0.5f * accel_rad;
+    obj->thetaAccel_rad = accel_rad;
+
+    if(speedRef > 0.0f)
+    {
+        obj->speedInterp_Hz = omega_rad * obj->tickScaler;
+    }
+    else
+    {
+        obj->speedInterp_Hz = -omega_rad * obj->tickScaler;
+    }
+
+    return;
+} // end of HALL_runEdge() function
+
+#ifdef HALL_CAL
+//------------------------------------------------------------------------------
+void HALL_resetCalibration(HALL_Handle handle)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    uint16_t  cnt;
+
+    for(cnt = 0; cnt < 7; cnt++)
+    {
+        obj->calSums[cnt].num = 0.0f;
+        obj->calSums[cnt].sumX = 0.0f;
+        obj->calSums[cnt].sumY = 0.0f;
+        obj->calSums[cnt].sumXX = 0.0f;
+        obj->calSums[cnt].sumXY = 0.0f;
+        obj->calSums[cnt].sumYY = 0.0f;
+    }
+
+    obj->calTail = obj->calHead;
+    obj->calNumEdges = 0;
+    obj->calNumOverrun = 0;
+    obj->flagCalSpeedNom = false;
+    obj->calDelay_radpHz = 0.0f;
+    obj->calStdError_rad = -1.0f;
+
+    return;
+}
+
+//------------------------------------------------------------------------------
+float32_t HALL_runCalibration(HALL_Handle handle)
+{
+    HALL_Obj *obj = (HALL_Obj *)handle;
+
+    float32_t sumSxx = 0.0f;
+    float32_t sumSxy = 0.0f;
+    float32_t sumSyy = 0.0f;
+    float32_t sumX = 0.0f;
+    float32_t numEdges = 0.0f;
+    float32_t numMin = 0.0f;
+    uint16_t  numSectors = 0;
+    uint16_t  cnt;
+
+    // accumulate the edges captured by the ISR, the ISR only writes calHead
+    while(obj->calTail != obj->calHead)
+    {
+        HALL_CalEdge *pEdge = &obj->calQueue[obj->calTail & (HALL_CAL_QUEUE_NUM - 1)];
+        uint16_t index = pEdge->hallIndex;
+
+        obj->calTail++;
+
+        if((index == 0) || (index > 6))
+        {
+            continue;
+        }
+
+        HALL_CalSums *pSums = &obj->calSums[index];
+
+        // the deviations from the first edge avoid the angle wrap and keep
+        // the float sums well conditioned
+        if(obj->flagCalSpeedNom == false)
+        {
+            obj->calSpeedNom_Hz = pEdge->speed_Hz;
+            obj->flagCalSpeedNom = true;
+        }
+
+        if(pSums->num == 0.0f)
+        {
+            obj->calAngleNom_rad[index] = pEdge->angle_rad;
+        }
+
+        float32_t x = pEdge->speed_Hz - obj->calSpeedNom_Hz;
+        float32_t y = pEdge->angle_rad - obj->calAngleNom_rad[index];
+
+        if(y > MATH_PI)
+        {
+            y -= MATH_TWO_PI;
+        }
+        else if(y < -MATH_PI)
+        {
+            y += MATH_TWO_PI;
+        }
+
+        pSums->num += 1.0f;
+        pSums->sumX += x;
+        pSums->sumY += y;
+        pSums->sumXX += x * x;
+        pSums->sumXY += x * y;
+        pSums->sumYY += y * y;
+
+        obj->calNumEdges++;
+    }
+
+    // the delay is fitted from the speed variation within each edge
+    for(cnt = 1; cnt < 7; cnt++)
+    {
+        HALL_CalSums *pSums = &obj->calSums[cnt];
+
+        if(pSums->num > 0.0f)
+        {
+            float32_t numInv = 1.0f / pSums->num;
+
+            sumSxx += pSums->sumXX - pSums->sumX * pSums->sumX * numInv;
+            sumSxy += pSums->sumXY - pSums->sumX * pSums->sumY * numInv;
+            sumSyy += pSums->sumYY - pSums->sumY * pSums->sumY * numInv;
+
+            sumX += pSums->sumX;
+            numEdges += pSums->num;
+            numMin = (numSectors == 0) ? pSums->num : MATH_min(numMin, pSums->num);
+            numSectors++;
+        }
+    }
+
+    // without speed variation the delay is part of the edge angles
+    obj->calDelay_radpHz = (sumSxx > (0.01f * numEdges)) ?
+                           (sumSxy / sumSxx) : 0.0f;
+
+    // the edge angles at the mean calibration speed, as HALL_run() uses them
+    float32_t speedMean = (numEdges > 0.0f) ? (sumX / numEdges) : 0.0f;
+
+    for(cnt = 1; cnt < 7; cnt++)
+    {
+        HALL_CalSums *pSums = &obj->calSums[cnt];
+
+        if(pSums->num > 0.0f)
+        {
+            float32_t angle_rad = obj->calAngleNom_rad[cnt] +
+                    (pSums->sumY - obj->calDelay_radpHz * pSums->sumX) / pSums->num +
+                    obj->calDelay_radpHz * speedMean;
+
+            if(angle_rad > MATH_PI)
+            {
+                angle_rad -= MATH_TWO_PI;
+            }
+            else if(angle_rad <= -MATH_PI)
+            {
+                angle_rad += MATH_TWO_PI;
+            }
+
+            obj->thetaCalBuff[cnt] = angle_rad;
+        }
+    }
+
+    // six edge angles and the delay are fitted
+    if((numSectors == 6) && (numEdges > 7.0f) && (numMin > 1.0f))
+    {
+        float32_t residual = MATH_max(sumSyy - obj->calDelay_radpHz * sumSxy, 0.0f);
+
+        obj->calStdError_rad = sqrtf(residual / ((numEdges - 7.0f) * numMin));
+    }
+    else
+    {
+        obj->calStdError_rad = -1.0f;
+    }
+
+    return(obj->calStdError_rad);
+} // end of HALL_runCalibration() function
+#endif  //HALL_CAL
 
 //----------------------------------------------------------------
 
@@ -72,6 +72,11 @@ extern "C"
 
 #include "gpio.h"
 
+//-----------------------------------------------------------------------------
+// defines
+//-----------------------------------------------------------------------------
+//! \brief Defines the number of commutation intervals in one electrical period
+#define ISBLDC_TIMESTAMP_NUM    6
 
 //-----------------------------------------------------------------------------
 // enumerations
@@ -107,11 +112,12 @@ typedef struct _ISBLDC_Obj_
     float32_t   speedInt_Hz;        // Hz
 
     uint32_t    timeStamp;          // Current Timestamp corresponding to a capture event
-    uint32_t    timeStampBuf[6];    // Timestamp buffer
-    uint32_t    timePeriod;         // Time Period
+    uint32_t    timeStampBuf[ISBLDC_TIMESTAMP_NUM];    // Timestamp ring buffer
+    uint32_t    timePeriod;         // Time Period, running sum of the ring buffer
     uint32_t    intTimer;           // Interval timer
 
     uint16_t    commState;          // Input: Values 0 to 5
+    uint16_t    timeStampIndex;     // Oldest entry of the timestamp ring buffer
 
     ISBLDC_PHS_e  bemfPhase;        // What phase to sense (A/B/C)
     ISBLDC_DIR_e  bemfDirect;       // BEMF integrator count direction (POS/NEG)
@@ -396,17 +402,18 @@ static inline void ISBLDC_run(ISBLDC_Handle handle, MATH_Vec3 *pVabcVec)
 
     if(obj->commTrigFlag == true)
     {
-        obj->timeStampBuf[0] = obj->timeStamp;
+        // replace the oldest commutation interval in the running sum
+        obj->timePeriod += obj->timeStamp -
+                           obj->timeStampBuf[obj->timeStampIndex];
+
+        obj->timeStampBuf[obj->timeStampIndex] = obj->timeStamp;
 
-        obj->timePeriod = (obj->timeStampBuf[0] + obj->timeStampBuf[1] +
-                           obj->timeStampBuf[2] + obj->timeStampBuf[3] +
-                           obj->timeStampBuf[4] + obj->timeStampBuf[5] );
+        obj->timeStampIndex++;
 
-        obj->timeStampBuf[5] = obj->timeStampBuf[4];
-        obj->timeStampBuf[4] = obj->timeStampBuf[3];
-        obj->timeStampBuf[3] = obj->timeStampBuf[2];
-        obj->timeStampBuf[2] = obj->timeStampBuf[1];
-        obj->timeStampBuf[1] = obj->timeStampBuf[0];
+        if(obj->timeStampIndex >= ISBLDC_TIMESTAMP_NUM)
+        {
+            obj->timeStampIndex = 0;
+        }
 
         obj->speedInt_Hz = obj->speedScaler / ((float32_t)obj->timePeriod);
 
@@ -72,15 +72,19 @@ void ISBLDC_setParams(ISBLDC_Handle handle, const USER_Params *pUserParams,
                       const float32_t threshold_max, const float32_t threshold_min)
 {
     ISBLDC_Obj *obj = (ISBLDC_Obj *)handle;
+    uint16_t cnt;
 
     obj->speedScaler = pUserParams->ctrlFreq_Hz;
 
     obj->timeStamp = 2000;
-    obj->timeStampBuf[0] = 2000;
-    obj->timeStampBuf[1] = 2000;
-    obj->timeStampBuf[2] = 2000;
-    obj->timeStampBuf[3] = 2000;
-    obj->timeStampBuf[4] = 2000;
+
+    for(cnt = 0; cnt < ISBLDC_TIMESTAMP_NUM; cnt++)
+    {
+        obj->timeStampBuf[cnt] = 2000;
+    }
+
+    obj->timePeriod = 2000 * ISBLDC_TIMESTAMP_NUM;
+    obj->timeStampIndex = 0;
 
     obj->commState = 0;
 
@@ -102,21 +106,11 @@ void ISBLDC_updateThresholdInt(ISBLDC_Handle handle, const float32_t speedRef)
 {
     ISBLDC_Obj *obj = (ISBLDC_Obj *)handle;
 
-    float32_t speedAbs = fabsf(speedRef);
-    float32_t thresholdInt = obj->thresholdMax - obj->thresholdSF * speedAbs;
+    // thresholdSF is the slope with the reciprocal of the maximum frequency
+    // already folded in by ISBLDC_setParams()
+    float32_t thresholdInt = obj->thresholdMax - obj->thresholdSF * fabsf(speedRef);
 
-    if(thresholdInt < obj->thresholdMin)
-    {
-        obj->thresholdInt = obj->thresholdMin;
-    }
-    else if(thresholdInt > obj->thresholdMax)
-    {
-        obj->thresholdInt = obj->thresholdMax;
-    }
-    else
-    {
-        obj->thresholdInt = thresholdInt;
-    }
+    obj->thresholdInt = __fsat(thresholdInt, obj->thresholdMax, obj->thresholdMin);
 
     return;
 }
@@ -125,6 +119,7 @@ void ISBLDC_updateThresholdInt(ISBLDC_Handle handle, const float32_t speedRef)
 void ISBLDC_resetState(ISBLDC_Handle handle)
 {
     ISBLDC_Obj *obj = (ISBLDC_Obj *)handle;
+    uint16_t cnt;
 
     obj->thresholdInt = obj->thresholdMax;
     obj->bemfLockFlag = false;
@@ -133,11 +128,14 @@ void ISBLDC_resetState(ISBLDC_Handle handle)
     obj->speedInt_Hz = 0.0f;
 
     obj->timeStamp = 2000;
-    obj->timeStampBuf[0] = 2000;
-    obj->timeStampBuf[1] = 2000;
-    obj->timeStampBuf[2] = 2000;
-    obj->timeStampBuf[3] = 2000;
-    obj->timeStampBuf[4] = 2000;
+
+    for(cnt = 0; cnt < ISBLDC_TIMESTAMP_NUM; cnt++)
+    {
+        obj->timeStampBuf[cnt] = 2000;
+    }
+
+    obj->timePeriod = 2000 * ISBLDC_TIMESTAMP_NUM;
+    obj->timeStampIndex = 0;
 
     obj->thresholdInt = obj->thresholdMax;
 
@@ -281,16 +279,18 @@ void ISBLDC_full_run(ISBLDC_Handle handle, MATH_Vec3 *pVabcVec)
 
     if(obj->commTrigFlag == true)
     {
+        // replace the oldest commutation interval in the running sum
+        obj->timePeriod += obj->timeStamp -
+                           obj->timeStampBuf[obj->timeStampIndex];
+
+        obj->timeStampBuf[obj->timeStampIndex] = obj->timeStamp;
 
-        obj->timePeriod = (obj->timeStamp       + obj->timeStampBuf[0] +
-                           obj->timeStampBuf[1] + obj->timeStampBuf[2] +
-                           obj->timeStampBuf[3] + obj->timeStampBuf[4] );
+        obj->timeStampIndex++;
 
-        obj->timeStampBuf[4] = obj->timeStampBuf[3];
-        obj->timeStampBuf[3] = obj->timeStampBuf[2];
-        obj->timeStampBuf[2] = obj->timeStampBuf[1];
-        obj->timeStampBuf[1] = obj->timeStampBuf[0];
-        obj->timeStampBuf[0] = obj->timeStamp;
+        if(obj->timeStampIndex >= ISBLDC_TIMESTAMP_NUM)
+        {
+            obj->timeStampIndex = 0;
+        }
 
         obj->speedInt_Hz = obj->speedScaler / ((float32_t)obj->timePeriod);
 
@@ -2,7 +2,7 @@
 //
 // FILE:   slip.h
 //
-// TITLE:  C28x InstaSPIN slip compensation library (fixed point)
+// TITLE:  C28x InstaSPIN slip compensation library (floating point)
 //
 //#############################################################################
 // $Copyright:
@@ -58,8 +58,7 @@ extern "C"
 //
 //*****************************************************************************
 
-#include "types.h"
-#include "libraries/iqmath/include/IQmathLib.h"
+#include "libraries/math/include/math.h"
 
 //*****************************************************************************
 //
@@ -68,11 +67,12 @@ extern "C"
 //*****************************************************************************
 typedef struct _SLIP_Obj_
 {
-    _iq sample_time;            //!< sample time of the SLIP module
-    int32_t enc_elec_angle;             //!< current electrical angle from encoder
-    int32_t incremental_slip;   //!< incremental amount of slip per sample time
-    int32_t enc_slip_angle;     //!< amount of total slip in Q24
-    int32_t enc_magnetic_angle; //!< current magnetic angle in Q24
+    float32_t sampleTime_sec;       //!< sample time of the SLIP module
+    float32_t slipScaler;           //!< 2*pi times the sample time
+    float32_t angleElec_rad;        //!< current electrical angle from encoder
+    float32_t incrementalSlip_rad;  //!< incremental amount of slip per sample
+    float32_t angleSlip_rad;        //!< amount of total slip, -pi ~ pi
+    float32_t angleMag_rad;         //!< current magnetic angle, -pi ~ pi
 } SLIP_Obj;
 
 //*****************************************************************************
@@ -88,15 +88,15 @@ typedef struct _SLIP_Handle_ *SLIP_Handle;
 //!
 //! \param[in] slipHandle    Handle to the SLIP object
 //!
-//! \return	   Magnetic angle in Q24
+//! \return	   Magnetic angle, -pi ~ pi rad
 //
 //*****************************************************************************
-static inline _iq
+static inline float32_t
 SLIP_getMagneticAngle(SLIP_Handle slipHandle)
 {
     SLIP_Obj *slip = (SLIP_Obj *) slipHandle;
 
-    return(slip->enc_magnetic_angle);
+    return(slip->angleMag_rad);
 }
 
 //*****************************************************************************
@@ -123,8 +123,44 @@ SLIP_init(void *pMemory, const size_t numBytes);
 //! \return	   Nothing
 //
 //*****************************************************************************
-extern void
-SLIP_run(SLIP_Handle slipHandle);
+static inline void
+SLIP_run(SLIP_Handle slipHandle)
+{
+    SLIP_Obj *slip = (SLIP_Obj *) slipHandle;
+    float32_t angleMag_rad;
+
+    //
+    // Update the slip angle, wrap around one revolution
+    //
+    slip->angleSlip_rad = slip->angleSlip_rad + slip->incrementalSlip_rad;
+
+    if(slip->angleSlip_rad >= MATH_PI)
+    {
+        slip->angleSlip_rad = slip->angleSlip_rad - MATH_TWO_PI;
+    }
+    else if(slip->angleSlip_rad < -MATH_PI)
+    {
+        slip->angleSlip_rad = slip->angleSlip_rad + MATH_TWO_PI;
+    }
+
+    //
+    // Add in compensation for slip, wrap around one revolution
+    //
+    angleMag_rad = slip->angleElec_rad + slip->angleSlip_rad;
+
+    if(angleMag_rad >= MATH_PI)
+    {
+        angleMag_rad = angleMag_rad - MATH_TWO_PI;
+    }
+    else if(angleMag_rad < -MATH_PI)
+    {
+        angleMag_rad = angleMag_rad + MATH_TWO_PI;
+    }
+
+    slip->angleMag_rad = angleMag_rad;
+
+    return;
+}
 
 //*****************************************************************************
 //
@@ -132,20 +168,20 @@ SLIP_run(SLIP_Handle slipHandle);
 //!
 //! \param[in] slipHandle         Handle to the SLIP object
 //!
-//! \param[in] electricalAngle    Current electrical angle in Q24
+//! \param[in] electricalAngle    Current electrical angle, -pi ~ pi rad
 //!
 //! \return    None
 //
 //*****************************************************************************
 static inline void
-SLIP_setElectricalAngle(SLIP_Handle slipHandle, _iq electricalAngle)
+SLIP_setElectricalAngle(SLIP_Handle slipHandle, const float32_t electricalAngle)
 {
     SLIP_Obj *slip = (SLIP_Obj *) slipHandle;
 
     //
     // Set the electrical angle
     //
-    slip->enc_elec_angle = electricalAngle;
+    slip->angleElec_rad = electricalAngle;
 
     return;
 }
@@ -158,13 +194,13 @@ SLIP_setElectricalAngle(SLIP_Handle slipHandle, _iq electricalAngle)
 //! \param[in] slipHandle      Handle to the SLIP object
 //!
 //! \param[in] slipVelocity    Velocity of the slip in electrical revolutions
-//!                            per second
+//!                            per second (Hz)
 //!
 //! \return    None
 //
 //*****************************************************************************
 static inline void
-SLIP_setSlipVelocity(SLIP_Handle slipHandle, _iq slipVelocity)
+SLIP_setSlipVelocity(SLIP_Handle slipHandle, const float32_t slipVelocity)
 {
     SLIP_Obj *slip = (SLIP_Obj *) slipHandle;
 
@@ -172,23 +208,72 @@ SLIP_setSlipVelocity(SLIP_Handle slipHandle, _iq slipVelocity)
     // Calculate the amount of incremental slip based on the slip velocity &
     // sample time
     //
-    slip->incremental_slip = _IQmpy(slipVelocity, slip->sample_time);
+    slip->incrementalSlip_rad = slipVelocity * slip->slipScaler;
 
     return;
 }
+
+//*****************************************************************************
+//
+//! \brief     Sets the inputs and runs the slip compensation in one call,
+//!            takes the float outputs of CTRL/EST/ENC without conversion
+//!
+//! \param[in] slipHandle      Handle to the SLIP object
+//!
+//! \param[in] angleElec_rad   Current electrical angle, -pi ~ pi rad
+//!
+//! \param[in] slip_Hz         Slip velocity, e.g. EST_getFslip_Hz(), Hz
+//!
+//! \return    Magnetic angle, -pi ~ pi rad
+//
+//*****************************************************************************
+static inline float32_t
+SLIP_runAngle(SLIP_Handle slipHandle, const float32_t angleElec_rad,
+              const float32_t slip_Hz)
+{
+    SLIP_setElectricalAngle(slipHandle, angleElec_rad);
+    SLIP_setSlipVelocity(slipHandle, slip_Hz);
+    SLIP_run(slipHandle);
+
+    return(SLIP_getMagneticAngle(slipHandle));
+}
+
+//*****************************************************************************
+//
+//! \brief     Runs the slip compensation of several axes in one call
+//!
+//! \param[in] pSlipHandles    Array of handles to the SLIP objects
+//!
+//! \param[in] numAxes         Number of axes
+//!
+//! \param[in] pAngleElec_rad  Array of electrical angles, -pi ~ pi rad
+//!
+//! \param[in] pSlip_Hz        Array of slip velocities, Hz
+//!
+//! \param[out] pAngleMag_rad  Array of magnetic angles, -pi ~ pi rad
+//!
+//! \return    None
+//
+//*****************************************************************************
+extern void
+SLIP_runMulti(SLIP_Handle *pSlipHandles, const uint16_t numAxes,
+              const float32_t *pAngleElec_rad, const float32_t *pSlip_Hz,
+              float32_t *pAngleMag_rad);
+
 //*****************************************************************************
 //
 //! \brief     Initializes slip object parameters
 //!
 //! \param[in] slipHandle   Handle to the SLIP object
 //!
-//! \param[in] sampleTime   Sample time that the SLIP object is being called at
+//! \param[in] sampleTime   Sample time that the SLIP object is being called
+//!                         at, sec
 //!
 //! \return    None
 //
 //*****************************************************************************
 extern void
-SLIP_setup(SLIP_Handle slipHandle, _iq sampleTime);
+SLIP_setup(SLIP_Handle slipHandle, const float32_t sampleTime);
 
 //*****************************************************************************
 //
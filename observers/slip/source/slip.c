@@ -2,7 +2,7 @@
 //
 // FILE:   slip.c
 //
-// TITLE:  C28x InstaSPIN slip compensation library (fixed point)
+// TITLE:  C28x InstaSPIN slip compensation library (floating point)
 //
 //#############################################################################
 // $Copyright:
@@ -71,7 +71,7 @@ SLIP_init(void *pMemory, const size_t numBytes)
 //
 //*****************************************************************************
 void
-SLIP_setup(SLIP_Handle slipHandle, _iq sampleTime)
+SLIP_setup(SLIP_Handle slipHandle, const float32_t sampleTime)
 {
     SLIP_Obj *slip;
 
@@ -83,61 +83,40 @@ SLIP_setup(SLIP_Handle slipHandle, _iq sampleTime)
     //
     // Set the sample time
     //
-    slip->sample_time = sampleTime;
+    slip->sampleTime_sec = sampleTime;
+    slip->slipScaler = MATH_TWO_PI * sampleTime;
 
     //
     // Initialize all other values to 0
     //
-    slip->enc_elec_angle = 0;
-    slip->enc_magnetic_angle = 0;
-    slip->enc_slip_angle = 0;
-    slip->incremental_slip = 0;
+    slip->angleElec_rad = 0.0f;
+    slip->angleMag_rad = 0.0f;
+    slip->angleSlip_rad = 0.0f;
+    slip->incrementalSlip_rad = 0.0f;
 
     return;
 } // end of SLIP_setup() function
 
 //*****************************************************************************
 //
-// SLIP_run
+// SLIP_runMulti
 //
 //*****************************************************************************
 void
-SLIP_run(SLIP_Handle slipHandle)
+SLIP_runMulti(SLIP_Handle *pSlipHandles, const uint16_t numAxes,
+              const float32_t *pAngleElec_rad, const float32_t *pSlip_Hz,
+              float32_t *pAngleMag_rad)
 {
-    SLIP_Obj *slip;
-    uint32_t temp;
+    uint16_t axis;
 
-    //
-    // Create an object pointer for manipulation
-    //
-    slip = (SLIP_Obj *) slipHandle;
-
-    //
-    // Update the slip angle
-    //
-    slip->enc_slip_angle = slip->enc_slip_angle + slip->incremental_slip;
-    
-    //
-    // Wrap around 1.0 (Q24)
-    //
-    slip->enc_slip_angle &= ((uint32_t) 0x00ffffff);
-    
-    //
-    // Add in compensation for slip
-    //
-    temp = slip->enc_elec_angle + slip->enc_slip_angle;
-    
-    //
-    // Wrap around 1.0 (Q24)
-    //
-    temp &= ((uint32_t) 0x00ffffff);
-    
-    //
-    // Store encoder magnetic angle
-    //
-    slip->enc_magnetic_angle = (_iq)temp;
+    for(axis = 0; axis < numAxes; axis++)
+    {
+        pAngleMag_rad[axis] = SLIP_runAngle(pSlipHandles[axis],
+                                            pAngleElec_rad[axis],
+                                            pSlip_Hz[axis]);
+    }
 
     return;
-} // end of SLIP_run() function
+} // end of SLIP_runMulti() function
 
 // end of file
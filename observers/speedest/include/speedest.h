@@ -0,0 +1,296 @@
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+#ifndef SPEED_EST_H
+#define SPEED_EST_H
+
+//! \file   libraries\observers\speedest\include\speedest.h
+//! \brief  Contains the public interface to the unified angle to speed
+//!         estimator, the backend is selected at compile time
+//!
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! \defgroup SPEED_EST SPEED_EST
+//! @{
+//
+//*****************************************************************************
+
+// the includes
+#ifdef __TMS320C28XX_CLA__
+#include "libraries/math/src/float/CLAmath.h"
+#else
+#include <math.h>
+#endif
+
+#include "libraries/math/include/math.h"
+
+//modules
+#include "userParams.h"
+
+// **************************************************************************
+// the defines
+
+//! \brief Defines the backends, a new backend adds an id here, its include
+//!        and run function below, its reset and setParams functions and a
+//!        case of SPDEST_runTrace() in speedest.c
+#define SPDEST_BACKEND_SPDCALC      0   // PLL on the angle in rad
+#define SPDEST_BACKEND_SPDFR        1   // filtered angle difference
+#define SPDEST_BACKEND_SPDOBS       2   // PLL on the angle in per unit
+#define SPDEST_NUM_BACKENDS         3
+
+//! \brief Defines the estimator bandwidth, the PLL backends are tuned to a
+//!        critically damped loop at this frequency, 0.0f keeps the gains of
+//!        the backend setParams functions. A speed step of more than about
+//!        15 times the bandwidth makes the PLL slip a cycle, 30 Hz follows a
+//!        200 Hz step with margin. SPDFR filters at 10 Hz either way
+#ifndef SPDEST_BANDWIDTH_Hz
+#define SPDEST_BANDWIDTH_Hz         30.0f
+#endif
+
+//! \brief Enables the accuracy and cost harness of a host build,
+//!        SPDEST_runTrace() runs any backend over the same angle trace, so
+//!        all the backends are built next to the selected one
+//!
+//#define SPDEST_HARNESS      1
+
+//! \brief Selects the backend
+#ifndef SPDEST_BACKEND
+#define SPDEST_BACKEND              SPDEST_BACKEND_SPDCALC
+#endif
+
+#if (SPDEST_BACKEND >= SPDEST_NUM_BACKENDS)
+#error "SPDEST_BACKEND is not a supported backend"
+#endif
+
+#if defined(SPDEST_HARNESS) || (SPDEST_BACKEND == SPDEST_BACKEND_SPDCALC)
+#include "speedcalc.h"
+#endif
+#if defined(SPDEST_HARNESS) || (SPDEST_BACKEND == SPDEST_BACKEND_SPDFR)
+#include "speedfr.h"
+#endif
+#if defined(SPDEST_HARNESS) || (SPDEST_BACKEND == SPDEST_BACKEND_SPDOBS)
+#include "speed_observer.h"
+#endif
+
+#ifdef SPDEST_HARNESS
+//! \brief Reads a free running 32-bit up counter to measure the cost of a
+//!        backend in SPDEST_runTrace(), the mean count is zero when not
+//!        defined
+#ifndef SPDEST_HARNESS_GET_COUNT
+#define SPDEST_HARNESS_GET_COUNT()      (0U)
+#endif  // SPDEST_HARNESS_GET_COUNT
+#endif  // SPDEST_HARNESS
+
+// **************************************************************************
+// the typedefs
+
+//! \brief Defines the unified speed estimator object, the input is always
+//!        the electrical angle in rad and the output the speed in Hz
+//!
+typedef struct _SPDEST_obj_
+{
+#if (SPDEST_BACKEND == SPDEST_BACKEND_SPDCALC)
+    SPDCALC_Obj   backend;          // backend object
+#elif (SPDEST_BACKEND == SPDEST_BACKEND_SPDFR)
+    SPDFR_Obj     backend;          // backend object
+#elif (SPDEST_BACKEND == SPDEST_BACKEND_SPDOBS)
+    SPD_OBSERVER  backend;          // backend object
+    float32_t     scaleFreq;        // per unit speed to Hz
+#endif
+    float32_t     speed_Hz;         // Output: speed, Hz
+} SPDEST_Obj;
+
+//! \brief Defines the SPDEST handle
+//!
+typedef struct _SPDEST_obj_ *SPDEST_Handle;
+
+#ifdef SPDEST_HARNESS
+//! \brief Defines the result of SPDEST_runTrace()
+//!
+typedef struct _SPDEST_TraceResult_
+{
+    float32_t     errorRms_Hz;      // rms speed error after the settling
+    float32_t     errorMax_Hz;      // maximum speed error after the settling
+    float32_t     countMean;        // mean counts of one run call
+} SPDEST_TraceResult;
+#endif  // SPDEST_HARNESS
+
+// ***************************************
+// extern functions
+// ***************************************
+//! \brief     Initializes the SPDEST estimator
+//! \param[in] pMemory   A pointer to the memory for the SPDEST object
+//! \param[in] numBytes  The number of bytes allocated for the SPDEST object
+//! \return    The SPDEST handle
+extern SPDEST_Handle SPDEST_init(void *pMemory, const size_t numBytes);
+
+//! \brief     Resets the SPDEST estimator
+//! \param[in] handle   The SPDEST handle
+extern void SPDEST_reset(SPDEST_Handle handle);
+
+//! \brief     Sets the SPDEST parameters, the backends get the same loop
+//!            bandwidth where they have one
+//! \param[in] handle       The SPDEST handle
+//! \param[in] pUserParams  The pointer to the user parameters
+extern void SPDEST_setParams(SPDEST_Handle handle, const USER_Params *pUserParams);
+
+#ifdef SPDEST_HARNESS
+//! \brief     Runs a backend over an angle trace and compares its speed with
+//!            the speed of the trace, the same trace runs every backend
+//!            through the same reset, setParams and run functions as SPDEST
+//! \param[in] backend       The backend, SPDEST_BACKEND_SPDCALC ...
+//! \param[in] pUserParams   The pointer to the user parameters
+//! \param[in] bandwidth_Hz  The bandwidth of the PLL backends, 0.0f keeps
+//!                          the gains of the backend
+//! \param[in] pAngle_rad    The electrical angles, -pi ~ pi or 0 ~ 2*pi rad
+//! \param[in] pSpeed_Hz     The speeds of the trace, Hz
+//! \param[in] numSamples    The number of samples of the trace
+//! \param[in] numSettle     The number of samples left out of the error
+//! \param[out] pResult      The pointer to the trace result
+extern void SPDEST_runTrace(const uint16_t backend,
+                            const USER_Params *pUserParams,
+                            const float32_t bandwidth_Hz,
+                            const float32_t *pAngle_rad,
+                            const float32_t *pSpeed_Hz,
+                            const uint32_t numSamples,
+                            const uint32_t numSettle,
+                            SPDEST_TraceResult *pResult);
+#endif  // SPDEST_HARNESS
+
+//! \brief     Gets the estimated speed
+//! \param[in] handle   The SPDEST handle
+//! \return    The speed, Hz
+static inline float32_t SPDEST_getSpeed_Hz(SPDEST_Handle handle)
+{
+    SPDEST_Obj *obj = (SPDEST_Obj *)handle;
+
+    return(obj->speed_Hz);
+}
+
+#if defined(SPDEST_HARNESS) || (SPDEST_BACKEND == SPDEST_BACKEND_SPDCALC)
+//! \brief     Runs the SPDCALC backend
+//! \param[in] pBackend   The pointer to the SPDCALC object
+//! \param[in] angle_rad  The electrical angle, -pi ~ pi or 0 ~ 2*pi rad
+//! \return    The speed, Hz
+static inline float32_t SPDEST_runSpdcalc(SPDCALC_Obj *pBackend,
+                                          const float32_t angle_rad)
+{
+    // the error roll in covers one revolution, keep the angle in -pi ~ pi
+    float32_t theta = (angle_rad >= MATH_PI) ? (angle_rad - MATH_TWO_PI) : angle_rad;
+
+    SPDCALC_run((SPDCALC_Handle)pBackend, theta);
+
+    return(pBackend->speed_Hz);
+}
+#endif
+
+#if defined(SPDEST_HARNESS) || (SPDEST_BACKEND == SPDEST_BACKEND_SPDFR)
+//! \brief     Runs the SPDFR backend
+//! \param[in] pBackend   The pointer to the SPDFR object
+//! \param[in] angle_rad  The electrical angle, -pi ~ pi or 0 ~ 2*pi rad
+//! \return    The speed, Hz
+static inline float32_t SPDEST_runSpdfr(SPDFR_Obj *pBackend,
+                                        const float32_t angle_rad)
+{
+    SPDFR_run((SPDFR_Handle)pBackend, angle_rad);
+
+    return(pBackend->speed_Hz);
+}
+#endif
+
+#if defined(SPDEST_HARNESS) || (SPDEST_BACKEND == SPDEST_BACKEND_SPDOBS)
+//! \brief     Runs the SPD_OBSERVER backend
+//! \param[in] pBackend   The pointer to the SPD_OBSERVER object
+//! \param[in] scaleFreq  The per unit speed to Hz
+//! \param[in] angle_rad  The electrical angle, -pi ~ pi or 0 ~ 2*pi rad
+//! \return    The speed, Hz
+static inline float32_t SPDEST_runSpdobs(SPD_OBSERVER *pBackend,
+                                         const float32_t scaleFreq,
+                                         const float32_t angle_rad)
+{
+    // the backend works on 0 ~ 1 per unit angle
+    float32_t theta = angle_rad * MATH_ONE_OVER_TWO_PI;
+
+    theta = (theta < 0.0f) ? (theta + 1.0f) : theta;
+
+    return(runSpeedObserve(pBackend, theta) * scaleFreq);
+}
+#endif
+
+//! \brief     Runs the SPDEST estimator
+//! \param[in] handle     The SPDEST handle
+//! \param[in] angle_rad  The electrical angle, -pi ~ pi or 0 ~ 2*pi rad
+static inline void SPDEST_run(SPDEST_Handle handle, const float32_t angle_rad)
+{
+    SPDEST_Obj *obj = (SPDEST_Obj *)handle;
+
+#if (SPDEST_BACKEND == SPDEST_BACKEND_SPDCALC)
+    obj->speed_Hz = SPDEST_runSpdcalc(&obj->backend, angle_rad);
+#elif (SPDEST_BACKEND == SPDEST_BACKEND_SPDFR)
+    obj->speed_Hz = SPDEST_runSpdfr(&obj->backend, angle_rad);
+#elif (SPDEST_BACKEND == SPDEST_BACKEND_SPDOBS)
+    obj->speed_Hz = SPDEST_runSpdobs(&obj->backend, obj->scaleFreq, angle_rad);
+#endif
+
+    return;
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif //end of SPEED_EST_H definition
@@ -0,0 +1,278 @@
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+
+//! \file   libraries\observers\speedest\source\speedest.c
+//! \brief  Portable C floating point code.  These functions define the
+//!         unified angle to speed estimator
+//!
+
+#include "speedest.h"
+
+// **************************************************************************
+// the defines
+
+// **************************************************************************
+// the globals
+
+
+// **************************************************************************
+// the functions
+
+SPDEST_Handle SPDEST_init(void *pMemory, const size_t numBytes)
+{
+    SPDEST_Handle handle;
+
+    if(numBytes < sizeof(SPDEST_Obj))
+    {
+        return((SPDEST_Handle)NULL);
+    }
+
+    // assign the handle
+    handle = (SPDEST_Handle)pMemory;
+
+    return(handle);
+} // end of SPDEST_init() function
+
+#if defined(SPDEST_HARNESS) || (SPDEST_BACKEND == SPDEST_BACKEND_SPDCALC)
+//------------------------------------------------------------------------------
+static void SPDEST_setParamsSpdcalc(SPDCALC_Obj *pBackend,
+                                    const USER_Params *pUserParams,
+                                    const float32_t bandwidth_Hz)
+{
+    // critically damped type 2 loop, Kp = 2 * wn, Ki = wn^2 per second
+    float32_t omegaN_rps = MATH_TWO_PI * bandwidth_Hz;
+
+    SPDCALC_setParams((SPDCALC_Handle)pBackend, pUserParams);
+
+    if(bandwidth_Hz > 0.0f)
+    {
+        pBackend->Kp = 2.0f * omegaN_rps;
+        pBackend->Ki = omegaN_rps * omegaN_rps * pUserParams->ctrlPeriod_sec;
+    }
+
+    SPDCALC_reset((SPDCALC_Handle)pBackend);
+
+    return;
+} // end of SPDEST_setParamsSpdcalc() function
+#endif
+
+#if defined(SPDEST_HARNESS) || (SPDEST_BACKEND == SPDEST_BACKEND_SPDFR)
+//------------------------------------------------------------------------------
+static void SPDEST_setParamsSpdfr(SPDFR_Obj *pBackend,
+                                  const USER_Params *pUserParams)
+{
+    SPDFR_setParams((SPDFR_Handle)pBackend, pUserParams);
+
+    SPDFR_reset((SPDFR_Handle)pBackend);
+
+    return;
+} // end of SPDEST_setParamsSpdfr() function
+#endif
+
+#if defined(SPDEST_HARNESS) || (SPDEST_BACKEND == SPDEST_BACKEND_SPDOBS)
+//------------------------------------------------------------------------------
+static void SPDEST_resetSpdobs(SPD_OBSERVER *pBackend)
+{
+    pBackend->Fbk = 0.0f;
+    pBackend->ui = 0.0f;
+    pBackend->Out = 0.0f;
+
+    return;
+} // end of SPDEST_resetSpdobs() function
+
+//------------------------------------------------------------------------------
+static void SPDEST_setParamsSpdobs(SPD_OBSERVER *pBackend,
+                                   const USER_Params *pUserParams,
+                                   const float32_t bandwidth_Hz)
+{
+    SPD_OBSERVER spdObsDefault = SPD_OBSERVER_DEFAULTS;
+    float32_t omegaN_rps = MATH_TWO_PI * bandwidth_Hz;
+
+    *pBackend = spdObsDefault;
+
+    // same loop as SPDCALC, scaled from rad and rad/s to per unit
+    if(bandwidth_Hz > 0.0f)
+    {
+        pBackend->Kp = 2.0f * omegaN_rps / pUserParams->maxFrequency_Hz;
+        pBackend->Ki = omegaN_rps * omegaN_rps *
+                       pUserParams->ctrlPeriod_sec /
+                       pUserParams->maxFrequency_Hz;
+    }
+
+    pBackend->thetaMax = pUserParams->maxFrequency_Hz *
+                         pUserParams->ctrlPeriod_sec;
+
+    SPDEST_resetSpdobs(pBackend);
+
+    return;
+} // end of SPDEST_setParamsSpdobs() function
+#endif
+
+//------------------------------------------------------------------------------
+void SPDEST_reset(SPDEST_Handle handle)
+{
+    SPDEST_Obj *obj = (SPDEST_Obj *)handle;
+
+#if (SPDEST_BACKEND == SPDEST_BACKEND_SPDCALC)
+    SPDCALC_reset((SPDCALC_Handle)&obj->backend);
+#elif (SPDEST_BACKEND == SPDEST_BACKEND_SPDFR)
+    SPDFR_reset((SPDFR_Handle)&obj->backend);
+#elif (SPDEST_BACKEND == SPDEST_BACKEND_SPDOBS)
+    SPDEST_resetSpdobs(&obj->backend);
+#endif
+
+    obj->speed_Hz = 0.0f;
+
+    return;
+} // end of SPDEST_reset() function
+
+//------------------------------------------------------------------------------
+void SPDEST_setParams(SPDEST_Handle handle, const USER_Params *pUserParams)
+{
+    SPDEST_Obj *obj = (SPDEST_Obj *)handle;
+
+#if (SPDEST_BACKEND == SPDEST_BACKEND_SPDCALC)
+    SPDEST_setParamsSpdcalc(&obj->backend, pUserParams, SPDEST_BANDWIDTH_Hz);
+#elif (SPDEST_BACKEND == SPDEST_BACKEND_SPDFR)
+    SPDEST_setParamsSpdfr(&obj->backend, pUserParams);
+#elif (SPDEST_BACKEND == SPDEST_BACKEND_SPDOBS)
+    SPDEST_setParamsSpdobs(&obj->backend, pUserParams, SPDEST_BANDWIDTH_Hz);
+
+    obj->scaleFreq = pUserParams->maxFrequency_Hz;
+#endif
+
+    obj->speed_Hz = 0.0f;
+
+    return;
+} // end of SPDEST_setParams() function
+
+#ifdef SPDEST_HARNESS
+//------------------------------------------------------------------------------
+void SPDEST_runTrace(const uint16_t backend,
+                     const USER_Params *pUserParams,
+                     const float32_t bandwidth_Hz,
+                     const float32_t *pAngle_rad,
+                     const float32_t *pSpeed_Hz,
+                     const uint32_t numSamples,
+                     const uint32_t numSettle,
+                     SPDEST_TraceResult *pResult)
+{
+    union
+    {
+        SPDCALC_Obj     spdcalc;
+        SPDFR_Obj       spdfr;
+        SPD_OBSERVER    spdobs;
+    } traceObj;
+
+    float32_t scaleFreq = pUserParams->maxFrequency_Hz;
+    float32_t errorSum = 0.0f;
+    float32_t errorMax_Hz = 0.0f;
+    float32_t speed_Hz = 0.0f;
+    float32_t error_Hz;
+    uint32_t countSum = 0U;
+    uint32_t countStart;
+    uint32_t cnt;
+
+    pResult->errorRms_Hz = 0.0f;
+    pResult->errorMax_Hz = 0.0f;
+    pResult->countMean = 0.0f;
+
+    switch(backend)
+    {
+        case SPDEST_BACKEND_SPDCALC:
+            SPDEST_setParamsSpdcalc(&traceObj.spdcalc, pUserParams, bandwidth_Hz);
+            break;
+
+        case SPDEST_BACKEND_SPDFR:
+            SPDEST_setParamsSpdfr(&traceObj.spdfr, pUserParams);
+            break;
+
+        case SPDEST_BACKEND_SPDOBS:
+            SPDEST_setParamsSpdobs(&traceObj.spdobs, pUserParams, bandwidth_Hz);
+            break;
+
+        default:
+            return;
+    }
+
+    for(cnt = 0; cnt < numSamples; cnt++)
+    {
+        countStart = SPDEST_HARNESS_GET_COUNT();
+
+        switch(backend)
+        {
+            case SPDEST_BACKEND_SPDCALC:
+                speed_Hz = SPDEST_runSpdcalc(&traceObj.spdcalc, pAngle_rad[cnt]);
+                break;
+
+            case SPDEST_BACKEND_SPDFR:
+                speed_Hz = SPDEST_runSpdfr(&traceObj.spdfr, pAngle_rad[cnt]);
+                break;
+
+            default:
+                speed_Hz = SPDEST_runSpdobs(&traceObj.spdobs, scaleFreq,
+                                            pAngle_rad[cnt]);
+                break;
+        }
+
+        countSum += SPDEST_HARNESS_GET_COUNT() - countStart;
+
+        if(cnt >= numSettle)
+        {
+            error_Hz = MATH_abs(speed_Hz - pSpeed_Hz[cnt]);
+            errorSum += error_Hz * error_Hz;
+            errorMax_Hz = MATH_max(errorMax_Hz, error_Hz);
+        }
+    }
+
+    if(numSamples > numSettle)
+    {
+        pResult->errorRms_Hz =
+                __sqrt(errorSum / (float32_t)(numSamples - numSettle));
+    }
+
+    pResult->errorMax_Hz = errorMax_Hz;
+
+    if(numSamples > 0U)
+    {
+        pResult->countMean = (float32_t)countSum / (float32_t)numSamples;
+    }
+
+    return;
+} // end of SPDEST_runTrace() function
+#endif  // SPDEST_HARNESS
+
+//----------------------------------------------------------------
+
+// end of file
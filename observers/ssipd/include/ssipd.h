@@ -71,11 +71,62 @@ extern "C"
 #include "userParams.h"
 
 
-#define SSIPD_DEBUG     1
+//! \brief Enables the per-pulse diagnostic records of each SSIPD object,
+//!        nothing is recorded and no memory is used when not defined
+//!
+//#define SSIPD_DEBUG     1
 
 #define SSIPD_DETECT_NUM      24.0f
 #define SSIPD_BUFF_NUM        (uint16_t)(SSIPD_DETECT_NUM + 2)
 
+//! \brief Defines the number of per-pulse diagnostic records, power of 2
+//!
+#define SSIPD_DIAG_NUM        32
+
+#if (SSIPD_DIAG_NUM & (SSIPD_DIAG_NUM - 1)) != 0
+#error SSIPD_DIAG_NUM must be a power of 2
+#endif
+
+//! \brief Defines the maximum number of coarse pulses of the coarse to fine search
+//!
+#define SSIPD_COARSE_NUM_MAX  12
+
+//*****************************************************************************
+//
+//! \brief Enumeration for the pulse search modes
+//
+//*****************************************************************************
+typedef enum
+{
+    SSIPD_SEARCH_LINEAR      = 0,   //!< positive and negative pulse per angle
+    SSIPD_SEARCH_COARSE_FINE = 1    //!< coarse grid, fine pairs, polarity pair
+} SSIPD_SearchMode_e;
+
+//*****************************************************************************
+//
+//! \brief Enumeration for the stages of the coarse to fine search
+//
+//*****************************************************************************
+typedef enum
+{
+    SSIPD_STAGE_COARSE     = 0,     //!< pulses over 0 to pi
+    SSIPD_STAGE_FINE_POS   = 1,     //!< pulse pi/4 above the estimated angle
+    SSIPD_STAGE_FINE_NEG   = 2,     //!< pulse pi/4 below the estimated angle
+    SSIPD_STAGE_POLARITY_0 = 3,     //!< pulse on the estimated angle
+    SSIPD_STAGE_POLARITY_1 = 4      //!< pulse opposite to the estimated angle
+} SSIPD_SearchStage_e;
+
+//*****************************************************************************
+//
+//! \brief Defines the per-pulse diagnostic record
+//
+//*****************************************************************************
+typedef struct _SSIPD_PulseRecord_
+{
+    float32_t  IsPeak_A;        // peak current square
+    float32_t  angle_rad;       // pulse angle
+} SSIPD_PulseRecord;
+
 //*****************************************************************************
 //
 //! \brief Defines the SSIPD_Obj object
@@ -93,8 +144,28 @@ typedef struct _SSIPD_obj_
     float32_t  angleInc_rad;    // Output: detection delta angle
     float32_t  angleMax_rad;    // Output: detection maximum angle
 
+    float32_t  IsPulse_A;       // peak current square of the present pulse
+    float32_t  IsPrev_A;        // peak current square of the previous pulse
+    float32_t  IsCoarse_A[SSIPD_COARSE_NUM_MAX];    // coarse pulse peaks
+    float32_t  coarseCos[SSIPD_COARSE_NUM_MAX];     // cos of twice the coarse angles
+    float32_t  coarseSin[SSIPD_COARSE_NUM_MAX];     // sin of twice the coarse angles
+    float32_t  angleCoarse_rad; // angle step of the coarse pulses
+    float32_t  IsAmp_A;         // saliency amplitude of the coarse pulse peaks
+    float32_t  angleEst_rad;    // estimated angle of the search
+
+    SSIPD_SearchMode_e  searchMode;     // pulse search mode
+    SSIPD_SearchStage_e searchStage;    // stage of the coarse to fine search
+    uint16_t   numCoarse;       // number of coarse pulses
+    uint16_t   numFine;         // number of fine pulse pairs
+    uint16_t   pulseIndex;      // pulse index within the stage
+
     uint16_t   pulseWidth;      //
     uint16_t   pulseCount;      //
+
+#ifdef SSIPD_DEBUG
+    SSIPD_PulseRecord diagBuff[SSIPD_DIAG_NUM];     // per-pulse records
+    uint16_t   diagCount;       // number of records since the start
+#endif // SSIPD_DEBUG
     bool       flagDirection;   //
     bool       flagEnablePWM;   //
     bool       flagDoneStatus;  //
@@ -108,12 +179,6 @@ typedef struct _SSIPD_obj_
 //*****************************************************************************
 typedef struct _SSIPD_obj_ *SSIPD_Handle;
 
-#ifdef SSIPD_DEBUG
-extern float32_t IsPeakBuff[SSIPD_BUFF_NUM];
-extern float32_t AngleBuff[SSIPD_BUFF_NUM];
-extern uint16_t peakBuffcnt;
-#endif // SSIPD_DEBUG
-
 //*****************************************************************************
 //
 // Prototypes for the APIs
@@ -134,6 +199,96 @@ extern void SSIPD_setParams(SSIPD_Handle handle, const float32_t volSet_V,
                             const float32_t angleInc_rad, const uint16_t pulseWidth);
 
 
+//! \brief     Sets the SSIPD pulse search
+//!            The linear search injects a positive and a negative pulse every
+//!            angleInc_rad. The coarse to fine search injects numCoarse pulses
+//!            over 0 to pi and takes the saliency angle from their second
+//!            harmonic, refines it with numFine pulse pairs at +/-pi/4 around
+//!            the estimate, then injects two pulses to find the polarity,
+//!            numCoarse + 2 * numFine + 2 pulses in total. The search
+//!            parameters are reset by SSIPD_setParams()
+//! \param[in] handle     The SSIPD handle
+//! \param[in] mode       The search mode
+//! \param[in] numCoarse  The number of coarse pulses, 3 to SSIPD_COARSE_NUM_MAX
+//! \param[in] numFine    The number of fine pulse pairs
+//! \return    None
+extern void SSIPD_setSearchParams(SSIPD_Handle handle,
+                                  const SSIPD_SearchMode_e mode,
+                                  const uint16_t numCoarse,
+                                  const uint16_t numFine);
+
+//! \brief     Processes the end of a pulse of the coarse to fine search and
+//!            sets the angle of the next pulse
+//! \param[in] handle  The SSIPD handle
+//! \return    None
+extern void SSIPD_runSearchStep(SSIPD_Handle handle);
+
+//! \brief     Gets the number of pulses of the SSIPD
+//! \param[in] handle  The SSIPD handle
+//! \return    The number of pulses
+static inline uint16_t SSIPD_getNumPulses(SSIPD_Handle handle)
+{
+    SSIPD_Obj *obj = (SSIPD_Obj *)handle;
+
+    if(obj->searchMode == SSIPD_SEARCH_COARSE_FINE)
+    {
+        return(obj->numCoarse + (obj->numFine << 1) + 2);
+    }
+
+    return((uint16_t)(obj->angleMax_rad / obj->angleInc_rad) * 2 + 1);
+}
+
+//! \brief     Records a pulse in the diagnostic ring buffer of the SSIPD,
+//!            compiles to nothing without SSIPD_DEBUG
+//! \param[in] handle     The SSIPD handle
+//! \param[in] IsPeak_A   The peak current square
+//! \param[in] angle_rad  The pulse angle
+//! \return    None
+static inline void SSIPD_recordPulse(SSIPD_Handle handle,
+                                     const float32_t IsPeak_A,
+                                     const float32_t angle_rad)
+{
+#ifdef SSIPD_DEBUG
+    SSIPD_Obj *obj = (SSIPD_Obj *)handle;
+    uint16_t index = obj->diagCount & (SSIPD_DIAG_NUM - 1);
+
+    obj->diagBuff[index].IsPeak_A = IsPeak_A;
+    obj->diagBuff[index].angle_rad = angle_rad;
+    obj->diagCount++;
+#else
+    (void)handle;
+    (void)IsPeak_A;
+    (void)angle_rad;
+#endif // SSIPD_DEBUG
+
+    return;
+}
+
+#ifdef SSIPD_DEBUG
+//! \brief     Gets the number of diagnostic records since the start
+//! \param[in] handle      The SSIPD handle
+//! \return    The number of records, the ring buffer holds the last
+//!            SSIPD_DIAG_NUM of them
+static inline uint16_t SSIPD_getDiagCount(SSIPD_Handle handle)
+{
+    SSIPD_Obj *obj = (SSIPD_Obj *)handle;
+
+    return(obj->diagCount);
+}
+
+//! \brief     Gets a diagnostic record
+//! \param[in] handle      The SSIPD handle
+//! \param[in] index       The record number since the start
+//! \return    The pointer to the record
+static inline const SSIPD_PulseRecord *
+SSIPD_getPulseRecord(SSIPD_Handle handle, const uint16_t index)
+{
+    SSIPD_Obj *obj = (SSIPD_Obj *)handle;
+
+    return(&obj->diagBuff[index & (SSIPD_DIAG_NUM - 1)]);
+}
+#endif // SSIPD_DEBUG
+
 //! \brief     Gets the enable PWM flag
 //! \param[in] handle      The SSIPD handle
 //! \return    the flag enable PWM
@@ -212,8 +367,13 @@ static inline void SSIPD_start(SSIPD_Handle handle)
 
     obj->IsPeak_A = 0.0f;
 
+    obj->IsPulse_A = 0.0f;
+    obj->angleEst_rad = 0.0f;
+    obj->searchStage = SSIPD_STAGE_COARSE;
+    obj->pulseIndex = 0;
+
 #ifdef SSIPD_DEBUG
-    peakBuffcnt = 0;
+    obj->diagCount = 0;
 #endif // SSIPD_DEBUG
 
 }
@@ -239,11 +399,62 @@ static inline void SSIPD_reset(SSIPD_Handle handle)
 
     obj->IsPeak_A = 0.0f;
 
+    obj->IsPulse_A = 0.0f;
+    obj->angleEst_rad = 0.0f;
+    obj->searchStage = SSIPD_STAGE_COARSE;
+    obj->pulseIndex = 0;
+
 #ifdef SSIPD_DEBUG
-    peakBuffcnt = 0;
+    obj->diagCount = 0;
 #endif // SSIPD_DEBUG
 }
 
+//! \brief     Runs the coarse to fine initial position detection
+//! \param[in] handle   The SSIPD handle
+//! \param[in] pIab     The pointer to the input vector
+//! \return    None
+static inline void SSIPD_runSearch(SSIPD_Handle handle, MATH_Vec2 *pIab)
+{
+    SSIPD_Obj *obj = (SSIPD_Obj *)handle;
+
+    if(obj->flagRunState == false)
+    {
+        obj->VdInject_V = 0.0f;
+        obj->flagEnablePWM = false;
+
+        return;
+    }
+
+    obj->pulseCount++;
+
+    if(obj->pulseCount >= (obj->pulseWidth<<4))
+    {
+        obj->pulseCount = 0;
+
+        SSIPD_runSearchStep(handle);
+    }
+    else if(obj->pulseCount <= obj->pulseWidth)
+    {
+        obj->flagEnablePWM = true;
+
+        obj->VdInject_V = obj->VdSet_V;
+
+        obj->IsTemp_A = pIab->value[0] * pIab->value[0] + pIab->value[1] * pIab->value[1];
+
+        if(obj->IsTemp_A > obj->IsPulse_A)
+        {
+            obj->IsPulse_A = obj->IsTemp_A;
+        }
+    }
+    else
+    {
+        obj->VdInject_V = 0.0f;
+        obj->flagEnablePWM = false;
+    }
+
+    return;
+}   // end of SSIPD_runSearch() function
+
 //! \brief     Runs six-pulse initial position detection
 //! \param[in] handle   The SSIPD handle
 //! \param[in] pIab     The pointer to the input vector
@@ -252,6 +463,13 @@ static inline void SSIPD_inine_run(SSIPD_Handle handle, MATH_Vec2 *pIab)
 {
     SSIPD_Obj *obj = (SSIPD_Obj *)handle;
 
+    if(obj->searchMode == SSIPD_SEARCH_COARSE_FINE)
+    {
+        SSIPD_runSearch(handle, pIab);
+
+        return;
+    }
+
     obj->pulseCount++;
 
     if(obj->pulseCount >= (obj->pulseWidth<<4))
@@ -272,15 +490,7 @@ static inline void SSIPD_inine_run(SSIPD_Handle handle, MATH_Vec2 *pIab)
             obj->flagDirection = false;
         }
 
-#ifdef SSIPD_DEBUG
-        IsPeakBuff[peakBuffcnt] = obj->IsPeak_A;
-        AngleBuff[peakBuffcnt] = obj->angleCmd_rad;
-        peakBuffcnt++;
-        if(peakBuffcnt >= SSIPD_BUFF_NUM)
-        {
-            peakBuffcnt = 0;
-        }
-#endif // SSIPD_DEBUG
+        SSIPD_recordPulse(handle, obj->IsPeak_A, obj->angleCmd_rad);
     }
     else if(obj->pulseCount <= obj->pulseWidth)
     {
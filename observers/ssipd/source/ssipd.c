@@ -39,12 +39,6 @@
 
 #include "ssipd.h"
 
-#ifdef SSIPD_DEBUG
-float32_t IsPeakBuff[SSIPD_BUFF_NUM];
-float32_t AngleBuff[SSIPD_BUFF_NUM];
-uint16_t peakBuffcnt = 0;
-#endif // SSIPD_DEBUG
-
 //
 // SSIPD_init
 //
@@ -84,6 +78,169 @@ void SSIPD_setParams(SSIPD_Handle handle, const float32_t volSet_V,
     obj->flagDirection = false;
     obj->flagRunState = false;
 
+    obj->searchStage = SSIPD_STAGE_COARSE;
+
+    SSIPD_setSearchParams(handle, SSIPD_SEARCH_LINEAR, 6, 3);
+
     return;
 }
+
+//
+// SSIPD_setSearchParams
+//
+void SSIPD_setSearchParams(SSIPD_Handle handle, const SSIPD_SearchMode_e mode,
+                           const uint16_t numCoarse, const uint16_t numFine)
+{
+    SSIPD_Obj *obj = (SSIPD_Obj *)handle;
+    uint16_t cnt;
+
+    obj->searchMode = mode;
+
+    // three coarse pulses are needed for the second harmonic
+    obj->numCoarse = (numCoarse < 3) ? 3 :
+                     ((numCoarse > SSIPD_COARSE_NUM_MAX) ?
+                      SSIPD_COARSE_NUM_MAX : numCoarse);
+    obj->numFine = numFine;
+
+    obj->angleCoarse_rad = MATH_PI / (float32_t)obj->numCoarse;
+
+    for(cnt = 0; cnt < obj->numCoarse; cnt++)
+    {
+        obj->coarseCos[cnt] = cosf(2.0f * (float32_t)cnt * obj->angleCoarse_rad);
+        obj->coarseSin[cnt] = sinf(2.0f * (float32_t)cnt * obj->angleCoarse_rad);
+    }
+
+    return;
+} // end of SSIPD_setSearchParams() function
+
+//
+// SSIPD_runSearchStep
+//
+void SSIPD_runSearchStep(SSIPD_Handle handle)
+{
+    SSIPD_Obj *obj = (SSIPD_Obj *)handle;
+
+    SSIPD_recordPulse(handle, obj->IsPulse_A, obj->angleCmd_rad);
+
+    if(obj->IsPulse_A > obj->IsPeak_A)
+    {
+        obj->IsPeak_A = obj->IsPulse_A;
+    }
+
+    switch(obj->searchStage)
+    {
+        case SSIPD_STAGE_COARSE:
+            obj->IsCoarse_A[obj->pulseIndex] = obj->IsPulse_A;
+            obj->pulseIndex++;
+
+            if(obj->pulseIndex < obj->numCoarse)
+            {
+                obj->angleCmd_rad = (float32_t)obj->pulseIndex *
+                                    obj->angleCoarse_rad;
+            }
+            else
+            {
+                float32_t IsCos = 0.0f;
+                float32_t IsSin = 0.0f;
+                uint16_t cnt;
+
+                // the saliency repeats every pi, so its angle is the phase of
+                // the second harmonic of the coarse pulse peaks
+                for(cnt = 0; cnt < obj->numCoarse; cnt++)
+                {
+                    IsCos += obj->IsCoarse_A[cnt] * obj->coarseCos[cnt];
+                    IsSin += obj->IsCoarse_A[cnt] * obj->coarseSin[cnt];
+                }
+
+                obj->angleEst_rad = 0.5f * atan2f(IsSin, IsCos);
+                obj->IsAmp_A = 2.0f * sqrtf(IsCos * IsCos + IsSin * IsSin) /
+                               (float32_t)obj->numCoarse;
+                obj->pulseIndex = 0;
+
+                if(obj->numFine > 0)
+                {
+                    obj->searchStage = SSIPD_STAGE_FINE_POS;
+                    obj->angleCmd_rad = obj->angleEst_rad + MATH_PI * 0.25f;
+                }
+                else
+                {
+                    obj->searchStage = SSIPD_STAGE_POLARITY_0;
+                    obj->angleCmd_rad = obj->angleEst_rad;
+                }
+            }
+            break;
+
+        case SSIPD_STAGE_FINE_POS:
+            obj->IsPrev_A = obj->IsPulse_A;
+
+            obj->searchStage = SSIPD_STAGE_FINE_NEG;
+            obj->angleCmd_rad = obj->angleEst_rad - MATH_PI * 0.25f;
+            break;
+
+        case SSIPD_STAGE_FINE_NEG:
+            // the pulses at +/-pi/4 differ by 2 * IsAmp * sin(2 * error),
+            // so the error is linear in their difference near the peak
+            if(obj->IsAmp_A > 0.0f)
+            {
+                obj->angleEst_rad += __fsat(0.25f * (obj->IsPrev_A - obj->IsPulse_A) /
+                                            obj->IsAmp_A,
+                                            0.5f * obj->angleCoarse_rad,
+                                            -0.5f * obj->angleCoarse_rad);
+            }
+
+            obj->pulseIndex++;
+
+            if(obj->pulseIndex < obj->numFine)
+            {
+                obj->searchStage = SSIPD_STAGE_FINE_POS;
+                obj->angleCmd_rad = obj->angleEst_rad + MATH_PI * 0.25f;
+            }
+            else
+            {
+                obj->searchStage = SSIPD_STAGE_POLARITY_0;
+                obj->angleCmd_rad = obj->angleEst_rad;
+            }
+            break;
+
+        case SSIPD_STAGE_POLARITY_0:
+            obj->IsPrev_A = obj->IsPulse_A;
+
+            obj->searchStage = SSIPD_STAGE_POLARITY_1;
+            obj->angleCmd_rad = obj->angleEst_rad + MATH_PI;
+            break;
+
+        case SSIPD_STAGE_POLARITY_1:
+        default:
+            // the magnet saturates the d-axis, the larger pulse is north
+            if(obj->IsPulse_A > obj->IsPrev_A)
+            {
+                obj->angleEst_rad += MATH_PI;
+            }
+
+            if(obj->angleEst_rad >= MATH_TWO_PI)
+            {
+                obj->angleEst_rad -= MATH_TWO_PI;
+            }
+            else if(obj->angleEst_rad < 0.0f)
+            {
+                obj->angleEst_rad += MATH_TWO_PI;
+            }
+
+            obj->angleOut_rad = obj->angleEst_rad;
+            obj->angleCmd_rad = obj->angleEst_rad;
+
+            obj->VdInject_V = 0.0f;
+            obj->IsTemp_A = 0.0f;
+
+            obj->flagEnablePWM = false;
+            obj->flagDoneStatus = true;
+            obj->flagRunState = false;
+            break;
+    }
+
+    obj->IsPulse_A = 0.0f;
+
+    return;
+} // end of SSIPD_runSearchStep() function
+
 // end of file
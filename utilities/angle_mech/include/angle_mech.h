@@ -0,0 +1,244 @@
+//#############################################################################
+//
+// FILE:   angle_mech.h
+//
+// TITLE:  C28x Mechanical angle tracker (ANGLE_MECH) (floating point)
+//
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+#ifndef ANGLE_MECH_H
+#define ANGLE_MECH_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! \defgroup ANGLE_MECH ANGLE_MECH
+//! @{
+//
+//*****************************************************************************
+
+#include "libraries/math/include/math.h"
+
+//*****************************************************************************
+//
+//! \brief Defines the mechanical angle tracker (ANGLE_MECH) object
+//!
+//! The tracker runs once per ISR on the electrical angle and publishes the
+//! mechanical angle, the mechanical revolution count and the table index for
+//! all consumers. The pole pair position and the revolution count are kept as
+//! integers, so the mechanical angle does not drift and the revolution count
+//! is exact.
+//
+//*****************************************************************************
+typedef struct _ANGLE_MECH_Obj_
+{
+    float32_t angleElecPrev_rad;    //!< the previous electrical angle, 0 ~ 2*pi
+    float32_t angleMech_rad;        //!< the mechanical angle, 0 ~ 2*pi
+    float32_t angleMechSf;          //!< the inverse of the number of pole pairs
+    float32_t indexSf;              //!< the table size over 2*pi
+    int32_t   revCount;             //!< the signed mechanical revolution count
+    uint16_t  polePairCnt;          //!< the pole pair position, 0 ~ pairs - 1
+    uint16_t  numPolePairs;         //!< the number of pole pairs
+    int16_t   index;                //!< the table index of the mechanical angle
+    int16_t   indexMax;             //!< the maximum table index
+} ANGLE_MECH_Obj;
+
+//*****************************************************************************
+//
+//! \brief Defines the ANGLE_MECH handle
+//
+//*****************************************************************************
+typedef struct _ANGLE_MECH_Obj_ *ANGLE_MECH_Handle;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs
+//
+//*****************************************************************************
+
+//! \brief     Gets the mechanical angle
+//! \param[in] handle  The mechanical angle tracker (ANGLE_MECH) handle
+//! \return    The mechanical angle, 0 ~ 2*pi rad
+static inline float32_t ANGLE_MECH_getAngleMech_rad(ANGLE_MECH_Handle handle)
+{
+    ANGLE_MECH_Obj *obj = (ANGLE_MECH_Obj *)handle;
+
+    return(obj->angleMech_rad);
+} // end of ANGLE_MECH_getAngleMech_rad() function
+
+
+//! \brief     Gets the table index of the mechanical angle
+//! \param[in] handle  The mechanical angle tracker (ANGLE_MECH) handle
+//! \return    The table index, 0 ~ table size - 1
+static inline int16_t ANGLE_MECH_getIndex(ANGLE_MECH_Handle handle)
+{
+    ANGLE_MECH_Obj *obj = (ANGLE_MECH_Obj *)handle;
+
+    return(obj->index);
+} // end of ANGLE_MECH_getIndex() function
+
+
+//! \brief     Gets the pole pair position of the electrical angle
+//! \param[in] handle  The mechanical angle tracker (ANGLE_MECH) handle
+//! \return    The pole pair position, 0 ~ number of pole pairs - 1
+static inline uint16_t ANGLE_MECH_getPolePairCount(ANGLE_MECH_Handle handle)
+{
+    ANGLE_MECH_Obj *obj = (ANGLE_MECH_Obj *)handle;
+
+    return(obj->polePairCnt);
+} // end of ANGLE_MECH_getPolePairCount() function
+
+
+//! \brief     Gets the mechanical revolution count
+//! \param[in] handle  The mechanical angle tracker (ANGLE_MECH) handle
+//! \return    The signed mechanical revolution count
+static inline int32_t ANGLE_MECH_getRevCount(ANGLE_MECH_Handle handle)
+{
+    ANGLE_MECH_Obj *obj = (ANGLE_MECH_Obj *)handle;
+
+    return(obj->revCount);
+} // end of ANGLE_MECH_getRevCount() function
+
+
+//! \brief     Resets the mechanical revolution count
+//! \param[in] handle  The mechanical angle tracker (ANGLE_MECH) handle
+static inline void ANGLE_MECH_resetRevCount(ANGLE_MECH_Handle handle)
+{
+    ANGLE_MECH_Obj *obj = (ANGLE_MECH_Obj *)handle;
+
+    obj->revCount = 0;
+
+    return;
+} // end of ANGLE_MECH_resetRevCount() function
+
+
+//! \brief     Initializes the mechanical angle tracker (ANGLE_MECH) module
+//! \param[in] pMemory   A pointer to the memory for the object
+//! \param[in] numBytes  The number of bytes allocated for the object, bytes
+//! \return    The mechanical angle tracker (ANGLE_MECH) object handle
+extern ANGLE_MECH_Handle ANGLE_MECH_init(void *pMemory, const size_t numBytes);
+
+
+//! \brief     Resets the mechanical angle tracker, the mechanical angle is
+//!            zero at the first electrical angle of zero after the reset
+//! \param[in] handle  The mechanical angle tracker (ANGLE_MECH) handle
+extern void ANGLE_MECH_reset(ANGLE_MECH_Handle handle);
+
+
+//! \brief     Sets the parameters of the mechanical angle tracker
+//! \param[in] handle        The mechanical angle tracker (ANGLE_MECH) handle
+//! \param[in] numPolePairs  The number of motor pole pairs
+//! \param[in] tableSize     The number of table points per mechanical revolution
+extern void ANGLE_MECH_setParams(ANGLE_MECH_Handle handle,
+                                 const uint16_t numPolePairs,
+                                 const uint16_t tableSize);
+
+
+//! \brief     Runs the mechanical angle tracker, called once per ISR
+//! \param[in] handle         The mechanical angle tracker (ANGLE_MECH) handle
+//! \param[in] angleElec_rad  The electrical angle, -pi ~ pi rad
+//! \return    The mechanical angle, 0 ~ 2*pi rad
+static inline float32_t ANGLE_MECH_run(ANGLE_MECH_Handle handle,
+                                       const float32_t angleElec_rad)
+{
+    ANGLE_MECH_Obj *obj = (ANGLE_MECH_Obj *)handle;
+    float32_t angleElecAbs_rad;
+    float32_t angleElecDelta_rad;
+    int16_t index;
+
+    // (-pi, pi) -> (0, 2*pi)
+    angleElecAbs_rad = (angleElec_rad < 0.0f) ?
+                       (angleElec_rad + MATH_TWO_PI) : angleElec_rad;
+
+    angleElecDelta_rad = angleElecAbs_rad - obj->angleElecPrev_rad;
+    obj->angleElecPrev_rad = angleElecAbs_rad;
+
+    // count the pole pairs when the electrical angle wraps around
+    if(angleElecDelta_rad < -MATH_PI)
+    {
+        obj->polePairCnt++;
+
+        if(obj->polePairCnt >= obj->numPolePairs)
+        {
+            obj->polePairCnt = 0;
+            obj->revCount++;
+        }
+    }
+    else if(angleElecDelta_rad > MATH_PI)
+    {
+        if(obj->polePairCnt == 0)
+        {
+            obj->polePairCnt = obj->numPolePairs;
+            obj->revCount--;
+        }
+
+        obj->polePairCnt--;
+    }
+
+    obj->angleMech_rad = ((float32_t)obj->polePairCnt * MATH_TWO_PI +
+                          angleElecAbs_rad) * obj->angleMechSf;
+
+    index = (int16_t)(obj->angleMech_rad * obj->indexSf);
+    obj->index = (index > obj->indexMax) ? obj->indexMax : index;
+
+    return(obj->angleMech_rad);
+} // end of ANGLE_MECH_run() function
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANGLE_MECH_H
@@ -0,0 +1,107 @@
+//#############################################################################
+//
+// FILE:   angle_mech.c
+//
+// TITLE:  C28x Mechanical angle tracker (ANGLE_MECH) (floating point)
+//
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+#include "angle_mech.h"
+
+// ****************************************************************************
+//
+// ANGLE_MECH_init
+//
+// ****************************************************************************
+ANGLE_MECH_Handle ANGLE_MECH_init(void *pMemory, const size_t numBytes)
+{
+    ANGLE_MECH_Handle handle;
+
+    if(numBytes < sizeof(ANGLE_MECH_Obj))
+    {
+        return((ANGLE_MECH_Handle)NULL);
+    }
+
+    //
+    // assign the handle
+    //
+    handle = (ANGLE_MECH_Handle)pMemory;
+
+    return(handle);
+} // end of ANGLE_MECH_init() function
+
+
+// ****************************************************************************
+//
+// ANGLE_MECH_reset
+//
+// ****************************************************************************
+void ANGLE_MECH_reset(ANGLE_MECH_Handle handle)
+{
+    ANGLE_MECH_Obj *obj = (ANGLE_MECH_Obj *)handle;
+
+    obj->angleElecPrev_rad = 0.0f;
+    obj->angleMech_rad = 0.0f;
+    obj->revCount = 0;
+    obj->polePairCnt = 0;
+    obj->index = 0;
+
+    return;
+} // end of ANGLE_MECH_reset() function
+
+
+// ****************************************************************************
+//
+// ANGLE_MECH_setParams
+//
+// ****************************************************************************
+void ANGLE_MECH_setParams(ANGLE_MECH_Handle handle,
+                          const uint16_t numPolePairs,
+                          const uint16_t tableSize)
+{
+    ANGLE_MECH_Obj *obj = (ANGLE_MECH_Obj *)handle;
+
+    obj->numPolePairs = numPolePairs;
+    obj->angleMechSf = 1.0f / ((float32_t)numPolePairs);
+    obj->indexSf = (float32_t)tableSize / MATH_TWO_PI;
+    obj->indexMax = (int16_t)tableSize - 1;
+
+    ANGLE_MECH_reset(handle);
+
+    return;
+} // end of ANGLE_MECH_setParams() function
+
+//
+// end of file
+//
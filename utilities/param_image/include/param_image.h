@@ -0,0 +1,254 @@
+//#############################################################################
+//
+// FILE:   param_image.h
+//
+// TITLE:  C28x Derived parameter image (PARAM_IMAGE)
+//
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+
+#ifndef PARAM_IMAGE_H
+#define PARAM_IMAGE_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! \defgroup PARAM_IMAGE PARAM_IMAGE
+//! @{
+//
+//*****************************************************************************
+
+#include "libraries/math/include/math.h"
+
+//*****************************************************************************
+//
+//! \brief Defines the maximum number of objects in a parameter image
+//
+//*****************************************************************************
+#define PARAM_IMAGE_NUM_OBJ_MAX         12
+
+//*****************************************************************************
+//
+//! \brief Defines the maximum number of pointer members in a parameter image
+//
+//*****************************************************************************
+#define PARAM_IMAGE_NUM_PTR_MAX         8
+
+//*****************************************************************************
+//
+//! \brief Defines the number of 16-bit words of the image header, tag, data
+//!        size, two checksum words and the layout signature
+//
+//*****************************************************************************
+#define PARAM_IMAGE_HEADER_SIZE         5
+
+//*****************************************************************************
+//
+//! \brief Defines the number of 16-bit words of a pointer member
+//
+//*****************************************************************************
+#define PARAM_IMAGE_PTR_SIZE            ((sizeof(void *) + sizeof(uint16_t) - 1) \
+                                         / sizeof(uint16_t))
+
+//*****************************************************************************
+//
+//! \brief Defines the ID of a NULL pointer member in the image
+//
+//*****************************************************************************
+#define PARAM_IMAGE_PTR_ID_NULL         0x0000
+
+//*****************************************************************************
+//
+//! \brief Defines the ID of a pointer member whose target is not one of the
+//!        objects of the image, the restore keeps the pointer of this boot
+//
+//*****************************************************************************
+#define PARAM_IMAGE_PTR_ID_KEEP         0xFFFF
+
+//*****************************************************************************
+//
+//! \brief Defines the number of image words written per source line
+//
+//*****************************************************************************
+#define PARAM_IMAGE_WORDS_PER_LINE      8
+
+//*****************************************************************************
+//
+//! \brief Defines the function that takes the generated source text
+//
+//*****************************************************************************
+typedef void (*PARAM_IMAGE_WriteFunc)(const char *pString);
+
+//*****************************************************************************
+//
+//! \brief Defines the derived parameter image (PARAM_IMAGE) object
+//!
+//! The image holds the objects as they are once their setParams functions
+//! have run, CTRL_setParams(), ESMO_setParams() and so on. It is generated
+//! once from the user parameter file: a build with that file runs the
+//! setParams functions, adds the objects in their boot order and calls
+//! PARAM_IMAGE_writeSource(), which writes the image as a const initialized
+//! array. That source is compiled into the application, so the image lives
+//! in flash (.const) and takes no RAM. At boot or after a fault trip the
+//! objects are restored with one copy per object instead of deriving all
+//! gains and scale factors again. The image carries a tag, its size and a
+//! checksum, so a stale image falls back to the setParams functions.
+//!
+//! No address is stored in the image. A pointer member added with
+//! PARAM_IMAGE_addPtr() is written as the ID of the image object it points
+//! into and the offset within that object, and the restore turns it back
+//! into the address of that object on this boot. A pointer to anything else
+//! keeps the value it has on this boot, and a NULL pointer stays NULL. The
+//! header carries a signature of the object sizes and the pointer members,
+//! so an image of a build with another object layout is refused. The image
+//! has to be generated again when the user parameter file changes
+//
+//*****************************************************************************
+typedef struct _PARAM_IMAGE_Obj_
+{
+    void      *pObj[PARAM_IMAGE_NUM_OBJ_MAX];       //!< the objects
+    size_t    objSize[PARAM_IMAGE_NUM_OBJ_MAX];     //!< the object sizes
+    uint16_t  ptrObj[PARAM_IMAGE_NUM_PTR_MAX];      //!< the object of each
+                                                    //!< pointer member
+    uint16_t  ptrWord[PARAM_IMAGE_NUM_PTR_MAX];     //!< the 16-bit word of
+                                                    //!< each pointer member
+                                                    //!< within its object
+    const uint16_t *pImage;     //!< the const image in flash
+    size_t    imageSize;        //!< the data size of the image, 16-bit words
+    uint16_t  numObjs;          //!< the number of objects
+    uint16_t  numPtrs;          //!< the number of pointer members
+} PARAM_IMAGE_Obj;
+
+//*****************************************************************************
+//
+//! \brief Defines the PARAM_IMAGE handle
+//
+//*****************************************************************************
+typedef struct _PARAM_IMAGE_Obj_ *PARAM_IMAGE_Handle;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs
+//
+//*****************************************************************************
+
+//! \brief     Initializes the derived parameter image (PARAM_IMAGE) module
+//!            with no image and an empty object list
+//! \param[in] pMemory   A pointer to the memory for the object
+//! \param[in] numBytes  The number of bytes allocated for the object, bytes
+//! \return    The derived parameter image (PARAM_IMAGE) object handle
+extern PARAM_IMAGE_Handle PARAM_IMAGE_init(void *pMemory, const size_t numBytes);
+
+
+//! \brief     Sets the const image, before or after the objects are added
+//! \param[in] handle  The derived parameter image (PARAM_IMAGE) handle
+//! \param[in] pImage  The pointer to the image generated by
+//!                    PARAM_IMAGE_writeSource(), NULL if there is none yet
+extern void PARAM_IMAGE_setImage(PARAM_IMAGE_Handle handle,
+                                 const uint16_t *pImage);
+
+
+//! \brief     Adds an object to the image, in the same order on every boot
+//! \param[in] handle    The derived parameter image (PARAM_IMAGE) handle
+//! \param[in] pObj      The pointer to the object
+//! \param[in] numBytes  The size of the object, sizeof(obj)
+//! \return    true if the object fits in the object list
+extern bool PARAM_IMAGE_addObj(PARAM_IMAGE_Handle handle,
+                               void *pObj, const size_t numBytes);
+
+
+//! \brief     Adds a pointer member of an object, so that the image holds the
+//!            object ID and offset it points to instead of its address, e.g.
+//!            PARAM_IMAGE_addPtr(handle, &ctrlObj.pGainSched)
+//! \param[in] handle  The derived parameter image (PARAM_IMAGE) handle
+//! \param[in] pPtr    The pointer to the pointer member, in an object that
+//!                    is already added
+//! \return    true if the member is in an added object and fits in the list
+extern bool PARAM_IMAGE_addPtr(PARAM_IMAGE_Handle handle, void *pPtr);
+
+
+//! \brief     Writes the objects as the C source of a const image, called
+//!            once the setParams functions of all the objects have run
+//! \param[in] handle  The derived parameter image (PARAM_IMAGE) handle
+//! \param[in] tag     The tag of the parameter set, e.g. a user parameter
+//!                    version, checked by PARAM_IMAGE_restore()
+//! \param[in] pName   The name of the generated array
+//! \param[in] pWrite  The function that takes the source text, one line at a
+//!                    time
+extern void PARAM_IMAGE_writeSource(PARAM_IMAGE_Handle handle,
+                                    const uint16_t tag, const char *pName,
+                                    PARAM_IMAGE_WriteFunc pWrite);
+
+
+//! \brief     Copies the const image into the objects
+//! \param[in] handle  The derived parameter image (PARAM_IMAGE) handle
+//! \param[in] tag     The tag of the parameter set
+//! \return    true if the image was valid and the objects are restored, false
+//!            if the setParams functions have to be run instead, also for an
+//!            image of another object list or object layout
+extern bool PARAM_IMAGE_restore(PARAM_IMAGE_Handle handle, const uint16_t tag);
+
+
+//! \brief     Stops restoring from the image, e.g. when a parameter is
+//!            changed online, until the image is set again
+//! \param[in] handle  The derived parameter image (PARAM_IMAGE) handle
+extern void PARAM_IMAGE_invalidate(PARAM_IMAGE_Handle handle);
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PARAM_IMAGE_H
@@ -0,0 +1,507 @@
+//#############################################################################
+//
+// FILE:   param_image.c
+//
+// TITLE:  C28x Derived parameter image (PARAM_IMAGE)
+//
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+
+#include "param_image.h"
+
+#include "string.h"
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_getPtrWord
+//
+// ****************************************************************************
+static uint16_t PARAM_IMAGE_getPtrWord(const PARAM_IMAGE_Obj *obj,
+                                       const uint16_t ptrNum,
+                                       const size_t word)
+{
+    const uint16_t *pData = (const uint16_t *)obj->pObj[obj->ptrObj[ptrNum]];
+    const char *pTarget;
+    const char *pBase;
+    uint16_t id = PARAM_IMAGE_PTR_ID_KEEP;
+    uint16_t offset = 0;
+    uint16_t cnt;
+
+    memcpy(&pTarget, &pData[obj->ptrWord[ptrNum]], sizeof(pTarget));
+
+    //
+    // the pointer is written as the ID of the object it points into and the
+    // offset within that object, the other words are zero
+    //
+    if(pTarget == NULL)
+    {
+        id = PARAM_IMAGE_PTR_ID_NULL;
+    }
+    else
+    {
+        for(cnt = 0; cnt < obj->numObjs; cnt++)
+        {
+            pBase = (const char *)obj->pObj[cnt];
+
+            if((pTarget >= pBase) && (pTarget < (pBase + obj->objSize[cnt])))
+            {
+                id = cnt + 1;
+                offset = (uint16_t)(pTarget - pBase);
+                break;
+            }
+        }
+    }
+
+    return((word == 0) ? id : ((word == 1) ? offset : 0));
+} // end of PARAM_IMAGE_getPtrWord() function
+
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_getWord
+//
+// ****************************************************************************
+static uint16_t PARAM_IMAGE_getWord(const PARAM_IMAGE_Obj *obj,
+                                    const uint16_t objNum, const size_t word)
+{
+    const uint16_t *pData = (const uint16_t *)obj->pObj[objNum];
+    uint16_t value = 0;
+    uint16_t cnt;
+
+    for(cnt = 0; cnt < obj->numPtrs; cnt++)
+    {
+        if((obj->ptrObj[cnt] == objNum) && (word >= obj->ptrWord[cnt]) &&
+           (word < (obj->ptrWord[cnt] + PARAM_IMAGE_PTR_SIZE)))
+        {
+            return(PARAM_IMAGE_getPtrWord(obj, cnt, word - obj->ptrWord[cnt]));
+        }
+    }
+
+    //
+    // an odd byte size on a byte addressed host is padded with zero
+    //
+    if(((word + 1) * sizeof(uint16_t)) > obj->objSize[objNum])
+    {
+        memcpy(&value, &pData[word],
+               obj->objSize[objNum] - (word * sizeof(uint16_t)));
+    }
+    else
+    {
+        value = pData[word];
+    }
+
+    return(value);
+} // end of PARAM_IMAGE_getWord() function
+
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_computeSignature
+//
+// ****************************************************************************
+static uint16_t PARAM_IMAGE_computeSignature(const PARAM_IMAGE_Obj *obj)
+{
+    uint16_t sig = 0xA5A5;
+    uint16_t cnt;
+
+    //
+    // rotate and add every word of the object list, so that another object
+    // size, pointer size or pointer member position gives another signature
+    //
+    sig = (uint16_t)((sig << 3) | (sig >> 13)) + (uint16_t)PARAM_IMAGE_PTR_SIZE;
+    sig = (uint16_t)((sig << 3) | (sig >> 13)) + obj->numObjs;
+
+    for(cnt = 0; cnt < obj->numObjs; cnt++)
+    {
+        sig = (uint16_t)((sig << 3) | (sig >> 13)) +
+              (uint16_t)obj->objSize[cnt];
+    }
+
+    sig = (uint16_t)((sig << 3) | (sig >> 13)) + obj->numPtrs;
+
+    for(cnt = 0; cnt < obj->numPtrs; cnt++)
+    {
+        sig = (uint16_t)((sig << 3) | (sig >> 13)) + obj->ptrObj[cnt];
+        sig = (uint16_t)((sig << 3) | (sig >> 13)) + obj->ptrWord[cnt];
+    }
+
+    return(sig);
+} // end of PARAM_IMAGE_computeSignature() function
+
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_writeHex
+//
+// ****************************************************************************
+static char *PARAM_IMAGE_writeHex(char *pText, const uint16_t value)
+{
+    static const char hexDigit[] = "0123456789ABCDEF";
+    int16_t shift;
+
+    *pText++ = '0';
+    *pText++ = 'x';
+
+    for(shift = 12; shift >= 0; shift -= 4)
+    {
+        *pText++ = hexDigit[(value >> shift) & 0xF];
+    }
+
+    return(pText);
+} // end of PARAM_IMAGE_writeHex() function
+
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_init
+//
+// ****************************************************************************
+PARAM_IMAGE_Handle PARAM_IMAGE_init(void *pMemory, const size_t numBytes)
+{
+    PARAM_IMAGE_Handle handle;
+
+    if(numBytes < sizeof(PARAM_IMAGE_Obj))
+    {
+        return((PARAM_IMAGE_Handle)NULL);
+    }
+
+    //
+    // assign the handle
+    //
+    handle = (PARAM_IMAGE_Handle)pMemory;
+
+    //
+    // no image and no objects, so the image and the objects can be set in
+    // either order
+    //
+    ((PARAM_IMAGE_Obj *)handle)->pImage = NULL;
+    ((PARAM_IMAGE_Obj *)handle)->imageSize = 0;
+    ((PARAM_IMAGE_Obj *)handle)->numObjs = 0;
+    ((PARAM_IMAGE_Obj *)handle)->numPtrs = 0;
+
+    return(handle);
+} // end of PARAM_IMAGE_init() function
+
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_setImage
+//
+// ****************************************************************************
+void PARAM_IMAGE_setImage(PARAM_IMAGE_Handle handle, const uint16_t *pImage)
+{
+    PARAM_IMAGE_Obj *obj = (PARAM_IMAGE_Obj *)handle;
+
+    obj->pImage = pImage;
+
+    return;
+} // end of PARAM_IMAGE_setImage() function
+
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_addObj
+//
+// ****************************************************************************
+bool PARAM_IMAGE_addObj(PARAM_IMAGE_Handle handle,
+                        void *pObj, const size_t numBytes)
+{
+    PARAM_IMAGE_Obj *obj = (PARAM_IMAGE_Obj *)handle;
+    size_t numWords = (numBytes + sizeof(uint16_t) - 1) / sizeof(uint16_t);
+
+    if(obj->numObjs >= PARAM_IMAGE_NUM_OBJ_MAX)
+    {
+        return(false);
+    }
+
+    obj->pObj[obj->numObjs] = pObj;
+    obj->objSize[obj->numObjs] = numBytes;
+    obj->numObjs++;
+
+    obj->imageSize += numWords;
+
+    return(true);
+} // end of PARAM_IMAGE_addObj() function
+
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_addPtr
+//
+// ****************************************************************************
+bool PARAM_IMAGE_addPtr(PARAM_IMAGE_Handle handle, void *pPtr)
+{
+    PARAM_IMAGE_Obj *obj = (PARAM_IMAGE_Obj *)handle;
+    const char *pMember = (const char *)pPtr;
+    const char *pBase;
+    size_t offset;
+    uint16_t cnt;
+
+    if(obj->numPtrs >= PARAM_IMAGE_NUM_PTR_MAX)
+    {
+        return(false);
+    }
+
+    //
+    // the member has to lie on a 16-bit word of an added object
+    //
+    for(cnt = 0; cnt < obj->numObjs; cnt++)
+    {
+        pBase = (const char *)obj->pObj[cnt];
+
+        if((pMember >= pBase) &&
+           ((pMember + sizeof(void *)) <= (pBase + obj->objSize[cnt])))
+        {
+            offset = (size_t)(pMember - pBase);
+
+            if((offset % sizeof(uint16_t)) != 0)
+            {
+                return(false);
+            }
+
+            obj->ptrObj[obj->numPtrs] = cnt;
+            obj->ptrWord[obj->numPtrs] = (uint16_t)(offset / sizeof(uint16_t));
+            obj->numPtrs++;
+
+            return(true);
+        }
+    }
+
+    return(false);
+} // end of PARAM_IMAGE_addPtr() function
+
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_writeSource
+//
+// ****************************************************************************
+void PARAM_IMAGE_writeSource(PARAM_IMAGE_Handle handle,
+                             const uint16_t tag, const char *pName,
+                             PARAM_IMAGE_WriteFunc pWrite)
+{
+    PARAM_IMAGE_Obj *obj = (PARAM_IMAGE_Obj *)handle;
+    char line[8 * PARAM_IMAGE_WORDS_PER_LINE + 8];
+    char *pText = line;
+    uint16_t header[PARAM_IMAGE_HEADER_SIZE];
+    uint16_t sum1 = 0x5A5A;     // a blank image does not check out
+    uint16_t sum2 = 0;
+    uint16_t value;
+    uint16_t cnt;
+    size_t word, numWords, numWritten = 0;
+
+    //
+    // Fletcher style sums over the object words, wrapping at 16 bits
+    //
+    for(cnt = 0; cnt < obj->numObjs; cnt++)
+    {
+        numWords = (obj->objSize[cnt] + sizeof(uint16_t) - 1) /
+                   sizeof(uint16_t);
+
+        for(word = 0; word < numWords; word++)
+        {
+            sum1 += PARAM_IMAGE_getWord(obj, cnt, word);
+            sum2 += sum1;
+        }
+    }
+
+    header[0] = tag;
+    header[1] = (uint16_t)obj->imageSize;
+    header[2] = sum1;
+    header[3] = sum2;
+    header[4] = PARAM_IMAGE_computeSignature(obj);
+
+    pWrite("const uint16_t ");
+    pWrite(pName);
+    pWrite("[] =\n{\n");
+
+    //
+    // the header and then the object words, in the order of addObj()
+    //
+    for(cnt = 0; cnt <= obj->numObjs; cnt++)
+    {
+        numWords = (cnt == 0) ? PARAM_IMAGE_HEADER_SIZE :
+                   ((obj->objSize[cnt - 1] + sizeof(uint16_t) - 1) /
+                    sizeof(uint16_t));
+
+        for(word = 0; word < numWords; word++)
+        {
+            value = (cnt == 0) ? header[word] :
+                    PARAM_IMAGE_getWord(obj, cnt - 1, word);
+
+            if((numWritten % PARAM_IMAGE_WORDS_PER_LINE) == 0)
+            {
+                *pText++ = ' ';
+                *pText++ = ' ';
+                *pText++ = ' ';
+            }
+
+            *pText++ = ' ';
+            pText = PARAM_IMAGE_writeHex(pText, value);
+            numWritten++;
+
+            if(numWritten < (PARAM_IMAGE_HEADER_SIZE + obj->imageSize))
+            {
+                *pText++ = ',';
+            }
+
+            if((numWritten % PARAM_IMAGE_WORDS_PER_LINE) == 0)
+            {
+                *pText++ = '\n';
+                *pText = '\0';
+                pWrite(line);
+                pText = line;
+            }
+        }
+    }
+
+    if(pText != line)
+    {
+        *pText++ = '\n';
+        *pText = '\0';
+        pWrite(line);
+    }
+
+    pWrite("};\n");
+
+    return;
+} // end of PARAM_IMAGE_writeSource() function
+
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_restore
+//
+// ****************************************************************************
+bool PARAM_IMAGE_restore(PARAM_IMAGE_Handle handle, const uint16_t tag)
+{
+    PARAM_IMAGE_Obj *obj = (PARAM_IMAGE_Obj *)handle;
+    const uint16_t *pData;
+    uint16_t *pMember;
+    void *pLive[PARAM_IMAGE_NUM_PTR_MAX];
+    char *pTarget;
+    uint16_t sum1 = 0x5A5A;
+    uint16_t sum2 = 0;
+    uint16_t id;
+    uint16_t cnt;
+    size_t word;
+
+    //
+    // the image must match the tag, the object list and the object layout of
+    // this boot
+    //
+    if((obj->pImage == NULL) || (obj->numObjs == 0) ||
+       (obj->pImage[0] != tag) ||
+       (obj->pImage[1] != (uint16_t)obj->imageSize) ||
+       (obj->pImage[4] != PARAM_IMAGE_computeSignature(obj)))
+    {
+        return(false);
+    }
+
+    pData = obj->pImage + PARAM_IMAGE_HEADER_SIZE;
+
+    for(word = 0; word < obj->imageSize; word++)
+    {
+        sum1 += pData[word];
+        sum2 += sum1;
+    }
+
+    if((sum1 != obj->pImage[2]) || (sum2 != obj->pImage[3]))
+    {
+        return(false);
+    }
+
+    for(cnt = 0; cnt < obj->numPtrs; cnt++)
+    {
+        pMember = (uint16_t *)obj->pObj[obj->ptrObj[cnt]] + obj->ptrWord[cnt];
+
+        memcpy(&pLive[cnt], pMember, sizeof(void *));
+    }
+
+    for(cnt = 0; cnt < obj->numObjs; cnt++)
+    {
+        memcpy(obj->pObj[cnt], pData, obj->objSize[cnt]);
+
+        pData += (obj->objSize[cnt] + sizeof(uint16_t) - 1) / sizeof(uint16_t);
+    }
+
+    //
+    // turn the object ID and offset of each pointer member back into the
+    // address of that object on this boot
+    //
+    for(cnt = 0; cnt < obj->numPtrs; cnt++)
+    {
+        pMember = (uint16_t *)obj->pObj[obj->ptrObj[cnt]] + obj->ptrWord[cnt];
+        id = pMember[0];
+
+        if(id == PARAM_IMAGE_PTR_ID_NULL)
+        {
+            pTarget = NULL;
+        }
+        else if(id <= obj->numObjs)
+        {
+            pTarget = (char *)obj->pObj[id - 1] + pMember[1];
+        }
+        else
+        {
+            pTarget = (char *)pLive[cnt];
+        }
+
+        memcpy(pMember, &pTarget, sizeof(void *));
+    }
+
+    return(true);
+} // end of PARAM_IMAGE_restore() function
+
+
+// ****************************************************************************
+//
+// PARAM_IMAGE_invalidate
+//
+// ****************************************************************************
+void PARAM_IMAGE_invalidate(PARAM_IMAGE_Handle handle)
+{
+    PARAM_IMAGE_Obj *obj = (PARAM_IMAGE_Obj *)handle;
+
+    //
+    // the image is in flash, so it is dropped rather than overwritten
+    //
+    obj->pImage = NULL;
+
+    return;
+} // end of PARAM_IMAGE_invalidate() function
+
+//
+// end of file
+//
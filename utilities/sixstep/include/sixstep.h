@@ -0,0 +1,394 @@
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+//! \file   ~/libraries/utilities/sixstep/include/sixstep.h
+//! \brief  Contains the public interface to the six-step commutation
+//!         engine (SIXSTEP) module routines
+//!
+
+#ifndef SIXSTEP_H
+#define SIXSTEP_H
+
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+//*****************************************************************************
+//
+//! \defgroup SIXSTEP SIXSTEP
+//! @{
+//
+//*****************************************************************************
+
+//
+// the includes
+//
+#ifdef __TMS320C28XX_CLA__
+#include "libraries/math/include/CLAmath.h"
+#else
+#include <math.h>
+#endif // __TMS320C28XX_CLA__
+
+#include "libraries/math/include/math.h"
+
+//modules
+#include "userParams.h"
+
+
+//
+// the defines
+//
+
+//! \brief Defines the number of sectors of one electrical period
+#define SIXSTEP_SECTOR_NUM      6
+
+//! \brief Defines the number of rotation directions
+#define SIXSTEP_DIR_NUM         2
+
+//! \brief Defines the number of consecutive open loop sectors with a bemf
+//!        trigger before the hand off to the closed loop
+#define SIXSTEP_BEMF_READY_NUM  6
+
+
+//
+// the typedefs
+//
+
+//! \brief Enumeration for the rotation direction, indexes the tables
+//!
+typedef enum
+{
+    SIXSTEP_DIR_NEG = 0,            //!< negative direction, sector counts down
+    SIXSTEP_DIR_POS = 1             //!< positive direction, sector counts up,
+                                    //!< the only one with a closed loop
+} SIXSTEP_Dir_e;
+
+//! \brief Enumeration for the commutation source
+//!
+typedef enum
+{
+    SIXSTEP_MODE_STOP        = 0,   //!< no commutation
+    SIXSTEP_MODE_OPEN_LOOP   = 1,   //!< the period generator commutates
+    SIXSTEP_MODE_CLOSED_LOOP = 2    //!< the bemf trigger commutates
+} SIXSTEP_Mode_e;
+
+//! \brief Defines one entry of the commutation table, the phases are
+//!        0 ~ 2 for A ~ C, the same numbering as ISBLDC_PHS_e
+//!
+typedef struct _SIXSTEP_CommEntry_
+{
+    uint16_t phaseHigh;             //!< phase with the high side switched
+    uint16_t phaseLow;              //!< phase with the low side on
+    uint16_t phaseFloat;            //!< open phase to sense the bemf
+    int16_t  bemfSign;              //!< bemf integration direction, +1 / -1
+} SIXSTEP_CommEntry;
+
+//! \brief Defines the six-step commutation engine (SIXSTEP) object
+//!
+typedef struct _SIXSTEP_Obj_
+{
+    SIXSTEP_CommEntry commTable[SIXSTEP_DIR_NUM][SIXSTEP_SECTOR_NUM];
+                                    // precomputed phase states per sector
+    uint16_t    sectorNext[SIXSTEP_DIR_NUM][SIXSTEP_SECTOR_NUM];
+                                    // next sector per direction
+
+    const SIXSTEP_CommEntry *pCommEntry;    // entry of the active sector
+
+    uint32_t    periodStart;        // open loop start period, ISR ticks
+    uint32_t    periodEnd;          // open loop end period, ISR ticks
+    uint32_t    periodOut;          // open loop period, ISR ticks
+    uint32_t    periodMeas;         // last commutation period, ISR ticks
+    uint32_t    counter;            // ISR ticks since the last commutation
+
+    uint16_t    rampDelay;          // ISR ticks per period decrement
+    uint16_t    rampDelayCount;     // counter for the ramp delay
+    uint16_t    sector;             // active sector, 0 ~ 5
+    uint16_t    bemfTrigCount;      // consecutive open loop sectors with a bemf trigger
+    SIXSTEP_Dir_e  dir;             // rotation direction
+    SIXSTEP_Mode_e mode;            // commutation source
+
+    bool        commTrigFlag;       // commutated in this ISR
+    bool        rampDoneFlag;       // open loop period reached the end
+    bool        bemfTrigFlag;       // bemf trigger seen in this open loop sector
+    bool        flagEnableClosedLoop;   // hand off once the ramp is done
+} SIXSTEP_Obj;
+
+
+//! \brief Defines the SIXSTEP handle
+//!
+typedef struct _SIXSTEP_Obj_  *SIXSTEP_Handle;
+
+
+//
+// the function prototypes
+//
+
+//! \brief     Gets the active sector
+//! \param[in] handle  The six-step commutation engine (SIXSTEP) handle
+//! \return    The active sector, 0 ~ 5, feeds ISBLDC_setCommState()
+static inline uint16_t SIXSTEP_getSector(SIXSTEP_Handle handle)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    return(obj->sector);
+} // end of SIXSTEP_getSector() function
+
+//! \brief     Gets the commutation table entry of the active sector
+//! \param[in] handle  The six-step commutation engine (SIXSTEP) handle
+//! \return    The pointer to the phase states of the active sector
+static inline const SIXSTEP_CommEntry *
+SIXSTEP_getCommEntry(SIXSTEP_Handle handle)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    return(obj->pCommEntry);
+} // end of SIXSTEP_getCommEntry() function
+
+//! \brief     Gets the commutation trig flag
+//! \param[in] handle  The six-step commutation engine (SIXSTEP) handle
+//! \return    The commutation trig flag, true in the ISR that commutated
+static inline bool SIXSTEP_getCommTrigFlag(SIXSTEP_Handle handle)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    return(obj->commTrigFlag);
+} // end of SIXSTEP_getCommTrigFlag() function
+
+//! \brief     Gets the ramp done flag
+//! \param[in] handle  The six-step commutation engine (SIXSTEP) handle
+//! \return    The ramp done flag
+static inline bool SIXSTEP_getRampDoneFlag(SIXSTEP_Handle handle)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    return(obj->rampDoneFlag);
+} // end of SIXSTEP_getRampDoneFlag() function
+
+//! \brief     Gets the commutation source
+//! \param[in] handle  The six-step commutation engine (SIXSTEP) handle
+//! \return    The commutation source
+static inline SIXSTEP_Mode_e SIXSTEP_getMode(SIXSTEP_Handle handle)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    return(obj->mode);
+} // end of SIXSTEP_getMode() function
+
+//! \brief     Gets the last commutation period
+//! \param[in] handle  The six-step commutation engine (SIXSTEP) handle
+//! \return    The last commutation period, ISR ticks
+static inline uint32_t SIXSTEP_getPeriod(SIXSTEP_Handle handle)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    return(obj->periodMeas);
+} // end of SIXSTEP_getPeriod() function
+
+//! \brief     Enables the hand off to the closed loop
+//! \details   The engine switches to SIXSTEP_MODE_CLOSED_LOOP on the first
+//!            open loop commutation after the ramp is done, once the bemf
+//!            trigger has fired in each of the last SIXSTEP_BEMF_READY_NUM
+//!            open loop sectors. The ISBLDC state filter integrates the bemf
+//!            for the positive direction only, so a run started with
+//!            SIXSTEP_DIR_NEG stays in the open loop
+//! \param[in] handle  The six-step commutation engine (SIXSTEP) handle
+//! \param[in] flagEnableClosedLoop  The enable flag
+static inline void
+SIXSTEP_setFlagEnableClosedLoop(SIXSTEP_Handle handle,
+                                const bool flagEnableClosedLoop)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    obj->flagEnableClosedLoop = flagEnableClosedLoop;
+
+    return;
+} // end of SIXSTEP_setFlagEnableClosedLoop() function
+
+//! \brief     Initializes the six-step commutation engine (SIXSTEP) module
+//! \param[in] pMemory   A pointer to the memory for the object
+//! \param[in] numBytes  The number of bytes allocated for the object, bytes
+//! \return    The six-step commutation engine (SIXSTEP) handle
+extern SIXSTEP_Handle SIXSTEP_init(void *pMemory, const size_t numBytes);
+
+//! \brief     Sets the parameters and loads the default commutation table
+//! \param[in] handle       The six-step commutation engine (SIXSTEP) handle
+//! \param[in] pUserParams  The pointer to the user parameters
+//! \param[in] freqStart_Hz The open loop start frequency of the motor
+//! \param[in] freqEnd_Hz   The open loop end frequency of the motor
+//! \param[in] rampDelay    The ISR ticks per period decrement
+extern void
+SIXSTEP_setParams(SIXSTEP_Handle handle, const USER_Params *pUserParams,
+                  const float32_t freqStart_Hz, const float32_t freqEnd_Hz,
+                  const uint16_t rampDelay);
+
+//! \brief     Sets the commutation table for the positive direction, the
+//!            negative direction table is derived from it
+//! \param[in] handle      The six-step commutation engine (SIXSTEP) handle
+//! \param[in] pCommTable  The phase states of sectors 0 ~ 5
+extern void
+SIXSTEP_setCommTable(SIXSTEP_Handle handle,
+                     const SIXSTEP_CommEntry *pCommTable);
+
+//! \brief     Starts the open loop from a sector, restarts the ramp
+//! \param[in] handle  The six-step commutation engine (SIXSTEP) handle
+//! \param[in] dir     The rotation direction
+//! \param[in] sector  The start (alignment) sector, 0 ~ 5
+extern void
+SIXSTEP_start(SIXSTEP_Handle handle, const SIXSTEP_Dir_e dir,
+              const uint16_t sector);
+
+//! \brief     Stops the commutation, the active sector is kept
+//! \param[in] handle  The six-step commutation engine (SIXSTEP) handle
+static inline void SIXSTEP_stop(SIXSTEP_Handle handle)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    obj->mode = SIXSTEP_MODE_STOP;
+    obj->commTrigFlag = false;
+
+    return;
+} // end of SIXSTEP_stop() function
+
+//! \brief  Runs the six-step commutation engine once per ISR
+//! \details   In open loop the period generator counts down the commutation
+//!            period like RIMPULSE, in closed loop the bemf trigger from
+//!            ISBLDC commutates. Both step the same sector counter through
+//!            the precomputed tables, no per-sector branching
+//! \param[in] handle       The six-step commutation engine (SIXSTEP) handle
+//! \param[in] commTrigIn   The bemf commutation trigger, commutates in the
+//!                         closed loop and qualifies the hand off in the
+//!                         open loop
+static inline void
+SIXSTEP_run(SIXSTEP_Handle handle, const bool commTrigIn)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    obj->commTrigFlag = false;
+
+    obj->counter++;
+
+    if(obj->mode == SIXSTEP_MODE_OPEN_LOOP)
+    {
+        if(obj->periodOut <= obj->periodEnd)
+        {
+            obj->rampDoneFlag = true;
+        }
+        else
+        {
+            obj->rampDelayCount++;
+
+            if(obj->rampDelayCount >= obj->rampDelay)
+            {
+                obj->periodOut--;
+                obj->rampDelayCount = 0;
+            }
+        }
+
+        if(commTrigIn == true)
+        {
+            obj->bemfTrigFlag = true;
+        }
+
+        obj->commTrigFlag = (obj->counter >= obj->periodOut);
+    }
+    else if(obj->mode == SIXSTEP_MODE_CLOSED_LOOP)
+    {
+        obj->commTrigFlag = commTrigIn;
+    }
+
+    if(obj->commTrigFlag == true)
+    {
+        obj->periodMeas = obj->counter;
+        obj->counter = 0;
+
+        obj->sector = obj->sectorNext[obj->dir][obj->sector];
+        obj->pCommEntry = &obj->commTable[obj->dir][obj->sector];
+
+        if(obj->mode == SIXSTEP_MODE_OPEN_LOOP)
+        {
+            // the bemf is tracked while every sector has seen a trigger
+            if(obj->bemfTrigFlag == true)
+            {
+                if(obj->bemfTrigCount < SIXSTEP_BEMF_READY_NUM)
+                {
+                    obj->bemfTrigCount++;
+                }
+            }
+            else
+            {
+                obj->bemfTrigCount = 0;
+            }
+
+            obj->bemfTrigFlag = false;
+
+            // hand off on a commutation boundary, the bemf integration
+            // starts at the beginning of a sector
+            if((obj->rampDoneFlag == true) &&
+               (obj->flagEnableClosedLoop == true) &&
+               (obj->dir == SIXSTEP_DIR_POS) &&
+               (obj->bemfTrigCount >= SIXSTEP_BEMF_READY_NUM))
+            {
+                obj->mode = SIXSTEP_MODE_CLOSED_LOOP;
+            }
+        }
+    }
+
+    return;
+} // end of SIXSTEP_run()
+
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif // extern "C"
+
+#endif // end of SIXSTEP_H definition
@@ -0,0 +1,181 @@
+//#############################################################################
+// $Copyright:
+// Copyright (C) 2017-2024 Texas Instruments Incorporated - http://www.ti.com/
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the
+//   distribution.
+//
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// $
+//#############################################################################
+
+//! \file   libraries/utilities/sixstep/source/sixstep.c
+//! \brief  Contains the public interface to the six-step commutation
+//!         engine (SIXSTEP) module routines
+//!
+
+// **************************************************************************
+//
+// the includes
+//
+#include "sixstep.h"
+
+
+#ifdef __TMS320C28XX_CLA__
+#pragma CODE_SECTION(SIXSTEP_init, "Cla1Prog2");
+#endif
+
+
+//
+// the globals
+//
+
+//! \brief The default positive direction commutation table, the floating
+//!        phase and the bemf direction match the ISBLDC state filter
+//!
+static const SIXSTEP_CommEntry SIXSTEP_commTableDefault[SIXSTEP_SECTOR_NUM] =
+{
+    { 0, 1, 2, -1 },        // sector 0: A+ B-, sense C falling
+    { 0, 2, 1,  1 },        // sector 1: A+ C-, sense B rising
+    { 1, 2, 0, -1 },        // sector 2: B+ C-, sense A falling
+    { 1, 0, 2,  1 },        // sector 3: B+ A-, sense C rising
+    { 2, 0, 1, -1 },        // sector 4: C+ A-, sense B falling
+    { 2, 1, 0,  1 }         // sector 5: C+ B-, sense A rising
+};
+
+
+//*****************************************************************************
+//
+// SIXSTEP_init
+//
+//*****************************************************************************
+SIXSTEP_Handle SIXSTEP_init(void *pMemory, const size_t numBytes)
+{
+    SIXSTEP_Handle handle;
+
+    if(numBytes < sizeof(SIXSTEP_Obj))
+    {
+        return((SIXSTEP_Handle)NULL);
+    }
+
+    //
+    // assign the handle
+    //
+    handle = (SIXSTEP_Handle)pMemory;
+
+    return(handle);
+} // end of SIXSTEP_init() function
+
+//*****************************************************************************
+//
+// SIXSTEP_setCommTable
+//
+//*****************************************************************************
+void SIXSTEP_setCommTable(SIXSTEP_Handle handle,
+                          const SIXSTEP_CommEntry *pCommTable)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+    uint16_t cnt;
+
+    for(cnt = 0; cnt < SIXSTEP_SECTOR_NUM; cnt++)
+    {
+        obj->commTable[SIXSTEP_DIR_POS][cnt] = pCommTable[cnt];
+
+        // reversing swaps the driven phases, the bemf on the open phase
+        // changes its slope
+        obj->commTable[SIXSTEP_DIR_NEG][cnt].phaseHigh = pCommTable[cnt].phaseLow;
+        obj->commTable[SIXSTEP_DIR_NEG][cnt].phaseLow = pCommTable[cnt].phaseHigh;
+        obj->commTable[SIXSTEP_DIR_NEG][cnt].phaseFloat = pCommTable[cnt].phaseFloat;
+        obj->commTable[SIXSTEP_DIR_NEG][cnt].bemfSign = -pCommTable[cnt].bemfSign;
+
+        obj->sectorNext[SIXSTEP_DIR_POS][cnt] =
+                (cnt == (SIXSTEP_SECTOR_NUM - 1)) ? 0 : (cnt + 1);
+        obj->sectorNext[SIXSTEP_DIR_NEG][cnt] =
+                (cnt == 0) ? (SIXSTEP_SECTOR_NUM - 1) : (cnt - 1);
+    }
+
+    obj->pCommEntry = &obj->commTable[obj->dir][obj->sector];
+
+    return;
+} // end of SIXSTEP_setCommTable() function
+
+//*****************************************************************************
+//
+// SIXSTEP_setParams
+//
+//*****************************************************************************
+void SIXSTEP_setParams(SIXSTEP_Handle handle, const USER_Params *pUserParams,
+                       const float32_t freqStart_Hz, const float32_t freqEnd_Hz,
+                       const uint16_t rampDelay)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    obj->periodEnd = (uint32_t)(pUserParams->ctrlFreq_Hz / freqEnd_Hz / 6.0f);
+    obj->periodStart = (uint32_t)(pUserParams->ctrlFreq_Hz / freqStart_Hz / 6.0f);
+    obj->rampDelay = rampDelay;
+
+    obj->dir = SIXSTEP_DIR_POS;
+    obj->sector = 0;
+    obj->flagEnableClosedLoop = false;
+
+    SIXSTEP_setCommTable(handle, &SIXSTEP_commTableDefault[0]);
+
+    SIXSTEP_start(handle, SIXSTEP_DIR_POS, 0);
+
+    obj->mode = SIXSTEP_MODE_STOP;
+
+    return;
+} // end of SIXSTEP_setParams() function
+
+//*****************************************************************************
+//
+// SIXSTEP_start
+//
+//*****************************************************************************
+void SIXSTEP_start(SIXSTEP_Handle handle, const SIXSTEP_Dir_e dir,
+                   const uint16_t sector)
+{
+    SIXSTEP_Obj *obj = (SIXSTEP_Obj *)handle;
+
+    obj->dir = dir;
+    obj->sector = (sector < SIXSTEP_SECTOR_NUM) ? sector : 0;
+    obj->pCommEntry = &obj->commTable[obj->dir][obj->sector];
+
+    obj->periodOut = obj->periodStart;
+    obj->periodMeas = obj->periodStart;
+    obj->counter = 0;
+    obj->rampDelayCount = 0;
+
+    obj->bemfTrigCount = 0;
+
+    obj->rampDoneFlag = false;
+    obj->commTrigFlag = false;
+    obj->bemfTrigFlag = false;
+    obj->mode = SIXSTEP_MODE_OPEN_LOOP;
+
+    return;
+} // end of SIXSTEP_start() function
+
+// end of the file